@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena_queue.h"
+
+#define DEFAULT_ARENA_QUEUE_CAPACITY 4
+#define NULL_OFFSET UINT32_MAX
+#define INSERTION_SORT_THRESHOLD 16
+
+///////////////////////////////////////////////////////////////////////////////
+///     ARENA QUEUE STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+struct ArenaQueueSt
+{
+    uint32_t *offsets;
+    const char *base;
+    size_t size;
+    size_t front;
+    size_t back;
+    size_t length;
+    size_t capacity;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     ARENA QUEUE MACRO UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Macro converting a stored offset back into a pointer
+ */
+#define DECODE(__ptr, __offset) \
+    ((__offset) == NULL_OFFSET ? NULL : (elem_t)((__ptr)->base + (__offset)))
+
+/**
+ * Macro converting a pointer into an offset, NULL_OFFSET if outside of the arena
+ */
+#define ENCODE(__ptr, __elem) \
+({ \
+    uint32_t __offset_enc = NULL_OFFSET; \
+    const char *__elem_enc = (const char *)(__elem); \
+    if (__elem_enc >= (__ptr)->base && __elem_enc < (__ptr)->base + (__ptr)->size) { \
+        __offset_enc = (uint32_t)(__elem_enc - (__ptr)->base); \
+    } \
+    __offset_enc; \
+})
+
+/**
+ * Macro to resize the offsets array
+ */
+#define ARENA_RESIZE(__ptr, __new_capacity) \
+({ \
+    int __result_res = FAILURE; \
+    uint32_t *__realloc_res = realloc((__ptr)->offsets, sizeof(uint32_t) * (__new_capacity)); \
+    if (__realloc_res) { \
+        (__ptr)->offsets = __realloc_res; \
+        (__ptr)->capacity = (__new_capacity); \
+        __result_res = SUCCESS; \
+    } \
+    (char)__result_res; \
+})
+
+/**
+ * Macro to shift entire queue to the left of the offsets array
+ */
+#define ARENA_SHIFT(__ptr) \
+    memmove((__ptr)->offsets, (__ptr)->offsets + (__ptr)->front, sizeof(uint32_t) * (__ptr)->length); \
+    (__ptr)->front = 0; \
+    (__ptr)->back = (__ptr)->length
+
+static inline int offset_cmp(const ArenaQueue q, const uint32_t a, const uint32_t b, const compare_func_t cmp) {
+    elem_t elem_a = DECODE(q, a);
+    elem_t elem_b = DECODE(q, b);
+    return cmp(&elem_a, &elem_b);
+}
+
+/**
+ * Sorts offsets[lo, hi) in place, recursing on the smaller partition to bound the stack depth
+ */
+static void offsets_sort(const ArenaQueue q, uint32_t *offsets, size_t lo, size_t hi, const compare_func_t cmp) {
+    uint32_t pivot, tmp;
+    size_t i, j, mid;
+
+    while (hi - lo > INSERTION_SORT_THRESHOLD) {
+        mid = lo + ((hi - lo)>>1);
+        if (offset_cmp(q, offsets[mid], offsets[lo], cmp) < 0) { tmp = offsets[mid]; offsets[mid] = offsets[lo]; offsets[lo] = tmp; }
+        if (offset_cmp(q, offsets[hi - 1], offsets[lo], cmp) < 0) { tmp = offsets[hi - 1]; offsets[hi - 1] = offsets[lo]; offsets[lo] = tmp; }
+        if (offset_cmp(q, offsets[hi - 1], offsets[mid], cmp) < 0) { tmp = offsets[hi - 1]; offsets[hi - 1] = offsets[mid]; offsets[mid] = tmp; }
+        pivot = offsets[mid];
+
+        i = lo;
+        j = hi - 1;
+        for (;;) {
+            while (offset_cmp(q, offsets[i], pivot, cmp) < 0) i++;
+            while (offset_cmp(q, pivot, offsets[j], cmp) < 0) j--;
+            if (i >= j) break;
+            tmp = offsets[i];
+            offsets[i] = offsets[j];
+            offsets[j] = tmp;
+            i++;
+            j--;
+        }
+
+        if (j + 1 - lo < hi - j - 1) {
+            offsets_sort(q, offsets, lo, j + 1, cmp);
+            lo = j + 1;
+        } else {
+            offsets_sort(q, offsets, j + 1, hi, cmp);
+            hi = j + 1;
+        }
+    }
+
+    for (i = lo + 1; i < hi; i++) {
+        tmp = offsets[i];
+        for (j = i; j > lo && offset_cmp(q, tmp, offsets[j - 1], cmp) < 0; j--) {
+            offsets[j] = offsets[j - 1];
+        }
+        offsets[j] = tmp;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     ARENA QUEUE FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+ArenaQueue arena_queue__empty(const void *base, const size_t size) {
+    if (!base || size >= NULL_OFFSET) return NULL;
+
+    ArenaQueue q = malloc(sizeof(struct ArenaQueueSt));
+    if (!q) return NULL;
+
+    q->offsets = malloc(sizeof(uint32_t) * DEFAULT_ARENA_QUEUE_CAPACITY);
+    if (!q->offsets) {
+        free(q);
+        return NULL;
+    }
+
+    q->base = base;
+    q->size = size;
+    q->front = 0;
+    q->back = 0;
+    q->length = 0;
+    q->capacity = DEFAULT_ARENA_QUEUE_CAPACITY;
+
+    return q;
+}
+
+inline char arena_queue__is_empty(const ArenaQueue q) {
+    return !q ? FAILURE : !q->length;
+}
+
+inline size_t arena_queue__length(const ArenaQueue q) {
+    return !q ? SIZE_MAX : q->length;
+}
+
+char arena_queue__enqueue(const ArenaQueue q, const elem_t element) {
+    if (!q) return FAILURE;
+
+    uint32_t offset = ENCODE(q, element);
+    if (element && offset == NULL_OFFSET) return FAILURE;
+
+    if (q->back == q->capacity) {
+        if (q->front >= q->capacity>>1) {
+            ARENA_SHIFT(q);
+        } else if (ARENA_RESIZE(q, q->capacity<<1) < 0) {
+            return FAILURE;
+        }
+    }
+
+    q->offsets[q->back] = offset;
+    q->back++;
+    q->length++;
+
+    return SUCCESS;
+}
+
+char arena_queue__dequeue(const ArenaQueue q, elem_t *front) {
+    size_t new_capacity;
+    if (!q || !q->length) return FAILURE;
+
+    if (front) {
+        *front = DECODE(q, q->offsets[q->front]);
+    }
+
+    q->front++;
+    q->length--;
+
+    new_capacity = q->capacity>>1;
+    if (q->length < new_capacity>>1 && new_capacity >= DEFAULT_ARENA_QUEUE_CAPACITY) {
+        ARENA_SHIFT(q);
+        ARENA_RESIZE(q, new_capacity);
+    }
+
+    return SUCCESS;
+}
+
+char arena_queue__peek_nth(const ArenaQueue q, const size_t i, elem_t *nth) {
+    if (!q || !nth || i >= q->length) return FAILURE;
+
+    *nth = DECODE(q, q->offsets[q->front + i]);
+
+    return SUCCESS;
+}
+
+elem_t *arena_queue__to_array(const ArenaQueue q) {
+    if (!q || !q->length) return NULL;
+
+    elem_t *res = malloc(sizeof(elem_t) * q->length);
+    if (!res) return NULL;
+
+    for (size_t i = 0; i < q->length; i++) {
+        res[i] = DECODE(q, q->offsets[q->front + i]);
+    }
+
+    return res;
+}
+
+size_t arena_queue__ptr_search(const ArenaQueue q, const elem_t elem) {
+    if (!q) return SIZE_MAX;
+
+    uint32_t offset = ENCODE(q, elem);
+    if (elem && offset == NULL_OFFSET) return SIZE_MAX;
+
+    for (size_t i = q->front; i < q->back; i++) {
+        if (q->offsets[i] == offset) return i - q->front;
+    }
+
+    return SIZE_MAX;
+}
+
+size_t arena_queue__search(const ArenaQueue q, const elem_t elem, const compare_func_t match) {
+    if (!q || !match) return SIZE_MAX;
+
+    for (size_t i = q->front; i < q->back; i++) {
+        if (match(DECODE(q, q->offsets[i]), elem)) return i - q->front;
+    }
+
+    return SIZE_MAX;
+}
+
+char arena_queue__contains(const ArenaQueue q, const elem_t elem, const compare_func_t match) {
+    if (!q || !match) return FAILURE;
+
+    return arena_queue__search(q, elem, match) != SIZE_MAX;
+}
+
+void arena_queue__foreach(const ArenaQueue q, const applying_func_t func, void *user_data) {
+    if (!q || !func) return;
+
+    for (size_t i = q->front; i < q->back; i++) {
+        func(DECODE(q, q->offsets[i]), user_data);
+    }
+}
+
+void arena_queue__sort(const ArenaQueue q, const compare_func_t cmp) {
+    if (!q || !cmp || q->length < 2) return;
+
+    offsets_sort(q, q->offsets, q->front, q->back, cmp);
+}
+
+void arena_queue__clear(const ArenaQueue q) {
+    if (!q) return;
+
+    ARENA_RESIZE(q, DEFAULT_ARENA_QUEUE_CAPACITY);
+
+    q->front = 0;
+    q->back = 0;
+    q->length = 0;
+}
+
+void arena_queue__free(const ArenaQueue q) {
+    if (!q) return;
+
+    free(q->offsets);
+    free(q);
+}
+
+void arena_queue__debug(const ArenaQueue q, const debug_func_t debug) {
+    setvbuf (stdout, NULL, _IONBF, 0);
+
+    printf("\n");
+    if (!q) {
+        printf("\tInvalid queue (NULL)");
+    } else if (!debug) {
+        printf("\tInvalid degug function (NULL)");
+    } else {
+        printf("\tArena queue:");
+        printf("\n\tQueue size: %lu\n\tQueue capacity: %lu\n\tArena size: %lu\n\tQueue content: \n\t", q->length
+                                                                                                     , q->capacity
+                                                                                                     , q->size);
+        printf("{ ");
+        for (size_t i = q->front; i < q->back; i++) {
+            debug(DECODE(q, q->offsets[i]));
+        }
+        printf("}");
+    }
+    printf("\n");
+}
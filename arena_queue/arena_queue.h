@@ -0,0 +1,172 @@
+#ifndef __ARENA_QUEUE_H__
+#define __ARENA_QUEUE_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a FIFO Abstract Data Type storing its elements as 32-bit offsets into an arena
+ *
+ * Notes :
+ * 1) Every element enqueued must be NULL or point inside the arena registered at creation,
+ * the arena must be smaller than 4GB. Elements are converted back to pointers at the API boundaries,
+ * each slot of the queue only uses 4 bytes instead of 8 on 64-bit hosts.
+ *
+ * 2) The queue never copies nor deletes its elements, they are owned by the arena.
+ *
+ * 3) Positions are relative to the front of the queue: the front element is at position 0.
+ */
+typedef struct ArenaQueueSt * ArenaQueue;
+
+
+/**
+ * @brief create an empty queue storing elements located in the given arena
+ * @note complexity: O(1)
+ * @param base address of the first byte of the arena
+ * @param size byte size of the arena, must be less than 4GB
+ * @return a pointer to queue on success, NULL on failure
+ */
+ArenaQueue arena_queue__empty(const void *base, const size_t size);
+
+
+/**
+ * @brief checks if the queue is empty
+ * @note complexity: O(1)
+ * @param q the queue
+ * @return 1 if the queue is empty, 0 if not, -1 on failure
+ */
+char arena_queue__is_empty(const ArenaQueue q);
+
+
+/**
+ * @brief number of elements in the queue
+ * @note complexity: O(1)
+ * @param q the queue
+ * @return the number of elements contained in the queue on success, SIZE_MAX on failure
+ */
+size_t arena_queue__length(const ArenaQueue q);
+
+
+/**
+ * @brief adds an element in the queue
+ * @note complexity: O(1)
+ * @param q the queue
+ * @param element the element to add, NULL or a pointer inside the arena
+ * @return 0 on success, -1 on failure
+ */
+char arena_queue__enqueue(const ArenaQueue q, const elem_t element);
+
+
+/**
+ * @brief removes the front element of the queue
+ * @note complexity: O(1)
+ * @param q the queue
+ * @param front pointer to storage variable, can be NULL
+ * @return 0 on success, -1 on failure
+ */
+char arena_queue__dequeue(const ArenaQueue q, elem_t *front);
+
+
+/**
+ * @brief retrieve the element at 'i' position of the queue without removing it
+ * @note complexity: O(1)
+ * @param q the queue
+ * @param i position
+ * @param nth pointer to storage variable
+ * @return 0 on success, -1 on failure
+ */
+char arena_queue__peek_nth(const ArenaQueue q, const size_t i, elem_t *nth);
+
+
+/**
+ * @brief retrieves all items of the queue stored in an array of pointers
+ * @details the array must be manually freed by user afterward
+ * @note complexity: O(n)
+ * @param q the queue
+ * @return a pointer to dynamically allocated array on success, NULL on failure
+ */
+elem_t *arena_queue__to_array(const ArenaQueue q);
+
+
+/**
+ * @brief search the given pointer
+ * @note complexity: O(n)
+ * @param q the queue
+ * @param elem the pointer to search
+ * @return the position of the pointer in the queue if it is contained in it, SIZE_MAX if not, SIZE_MAX on failure
+ */
+size_t arena_queue__ptr_search(const ArenaQueue q, const elem_t elem);
+
+
+/**
+ * @brief search the given element
+ * @note complexity: O(n)
+ * @param q the queue
+ * @param elem the element to search
+ * @param match the matching function
+ * @return the position of the element in the queue if it is contained in it, SIZE_MAX if not, SIZE_MAX on failure
+ */
+size_t arena_queue__search(const ArenaQueue q, const elem_t elem, const compare_func_t match);
+
+
+/**
+ * @brief checks if a given element is on the queue
+ * @note complexity: O(n)
+ * @param q the queue
+ * @param elem the element
+ * @param match the matching function
+ * @return 1 if the element is on the queue, 0 if not, -1 on failure
+ */
+char arena_queue__contains(const ArenaQueue q, const elem_t elem, const compare_func_t match);
+
+
+/**
+ * @brief maps the given function to the queue
+ * @details an element contained several times in the queue is visited once per occurrence
+ * @note complexity: O(n)
+ * @param q the queue
+ * @param func the applying function
+ * @param user_data optional data to be used as an additional argument of the application function
+ */
+void arena_queue__foreach(const ArenaQueue q, const applying_func_t func, void *user_data);
+
+
+/**
+ * @brief sorts the queue elements in place using the given compare function
+ * @details 'cmp' receives pointers to elements, as with qsort
+ * @note complexity: O(n*log(n))
+ * @param q the queue
+ * @param cmp the compare function
+ */
+void arena_queue__sort(const ArenaQueue q, const compare_func_t cmp);
+
+
+/**
+ * @brief removes all elements in the queue
+ * @note complexity: O(1)
+ * @param q the queue
+ */
+void arena_queue__clear(const ArenaQueue q);
+
+
+/**
+ * @brief frees all allocated memory used by the queue
+ * @details the arena and the elements it contains are left untouched
+ * @note complexity: O(1)
+ * @param q the queue
+ */
+void arena_queue__free(const ArenaQueue q);
+
+
+/**
+ * @brief prints the queue's content
+ * @note complexity: O(n)
+ * @param q the queue
+ * @param debug the debug function
+ */
+void arena_queue__debug(const ArenaQueue q, const debug_func_t debug);
+
+
+#endif
@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../queue/queue.h"
+#include "../common/defs.h"
+#include "../common/vec.h"
+
+/**
+ * Scan benchmark on pointer-heavy data
+ *
+ * Builds a queue of pointers to nodes laid out in random order in memory, the node set being larger
+ * than the last level cache, then times the scans dereferencing every element.
+ * Compile with -DPREFETCH_DISTANCE=0 to measure the scans without software prefetching, and with
+ * -DELEMS_ALIGNMENT=64 to measure them on cache line aligned element buffers.
+ *
+ * Usage: ./bench_scan [n_elems] [n_rounds]
+ */
+
+#define DEFAULT_N_ELEMS (1<<21)
+#define DEFAULT_N_ROUNDS 5
+
+typedef struct {
+    uint64_t key;
+    char payload[56];
+} Node;
+
+static elem_t borrow(elem_t e) {
+    return e;
+}
+
+static void forget(elem_t e) {
+    return;
+}
+
+static int match_key(const void *a, const void *b) {
+    return ((const Node *)a)->key == *(const uint64_t *)b;
+}
+
+static char is_small(const void *a, void *user_data) {
+    return ((const Node *)a)->key < *(const uint64_t *)user_data;
+}
+
+static void sum_keys(const void *a, void *user_data) {
+    *(uint64_t *)user_data += ((const Node *)a)->key;
+}
+
+static double elapsed_ms(const clock_t start) {
+    return 1000.0 * (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv)
+{
+    size_t n_elems = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_N_ELEMS;
+    int n_rounds = argc > 2 ? atoi(argv[2]) : DEFAULT_N_ROUNDS;
+    uint64_t missing = UINT64_MAX;
+    uint64_t bound = n_elems;
+    uint64_t none = 0;
+    uint64_t sum = 0;
+    size_t *order;
+    Node *nodes;
+    Queue q;
+    clock_t start;
+    char res = 0;
+
+    nodes = malloc(sizeof(Node) * n_elems);
+    order = malloc(sizeof(size_t) * n_elems);
+    q = queue__empty_copy_enabled(borrow, forget);
+    if (!nodes || !order || !q) {
+        printf("allocation failure\n");
+        return EXIT_FAILURE;
+    }
+
+    srand(42);
+    for (size_t i = 0; i < n_elems; i++) {
+        nodes[i].key = i;
+        order[i] = i;
+    }
+    for (size_t i = n_elems - 1; i > 0; i--) {
+        size_t j = ((size_t)rand() * ((size_t)RAND_MAX + 1) + (size_t)rand()) % (i + 1);
+        size_t tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    for (size_t i = 0; i < n_elems; i++) {
+        queue__enqueue(q, nodes + order[i]);
+    }
+
+    printf("scan benchmark: %lu elements, %d rounds, prefetch distance %d\n", n_elems, n_rounds, PREFETCH_DISTANCE);
+
+    start = clock();
+    for (int r = 0; r < n_rounds; r++) {
+        res ^= queue__search(q, &missing, match_key) == SIZE_MAX;
+    }
+    printf("\tsearch:  %8.2f ms/round\n", elapsed_ms(start) / n_rounds);
+
+    start = clock();
+    for (int r = 0; r < n_rounds; r++) {
+        res ^= queue__all(q, is_small, &bound);
+    }
+    printf("\tall:     %8.2f ms/round\n", elapsed_ms(start) / n_rounds);
+
+    start = clock();
+    for (int r = 0; r < n_rounds; r++) {
+        res ^= queue__any(q, is_small, &none);
+    }
+    printf("\tany:     %8.2f ms/round\n", elapsed_ms(start) / n_rounds);
+
+    start = clock();
+    for (int r = 0; r < n_rounds; r++) {
+        queue__foreach(q, sum_keys, &sum);
+    }
+    printf("\tforeach: %8.2f ms/round\n", elapsed_ms(start) / n_rounds);
+
+    start = clock();
+    queue__filter(q, is_small, &bound);
+    printf("\tfilter:  %8.2f ms\n", elapsed_ms(start));
+
+    printf("\t(checksum %lu)\n", (unsigned long)(sum + (uint64_t)res));
+
+    queue__free(q);
+    free(order);
+    free(nodes);
+
+    return EXIT_SUCCESS;
+}
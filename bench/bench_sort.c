@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../queue/queue.h"
+#include "../common/defs.h"
+
+/**
+ * Sort benchmark on several input distributions
+ *
+ * Times 'queue__sort' against a plain qsort of the same elements, on random, sorted, reverse sorted and
+ * few unique values, and on many tiny queues.
+ *
+ * Usage: ./bench_sort [n_elems] [n_rounds]
+ */
+
+#define DEFAULT_N_ELEMS (1<<20)
+#define DEFAULT_N_ROUNDS 5
+#define TINY_LENGTH 16
+
+typedef enum { RANDOM, SORTED, REVERSED, FEW_UNIQUE, N_DISTRIBUTIONS } Distribution;
+
+static const char *distribution_names[N_DISTRIBUTIONS] = {"random", "sorted", "reversed", "few unique"};
+
+static int compare_values(const void *a, const void *b) {
+    uint64_t x = **(uint64_t *const *)a;
+    uint64_t y = **(uint64_t *const *)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t random_value(void) {
+    return (uint64_t)rand() * ((uint64_t)RAND_MAX + 1) + (uint64_t)rand();
+}
+
+static void fill_values(uint64_t *values, const size_t n, const Distribution d) {
+    for (size_t i = 0; i < n; i++) {
+        switch (d) {
+            case RANDOM:     values[i] = random_value(); break;
+            case SORTED:     values[i] = i; break;
+            case REVERSED:   values[i] = n - i; break;
+            default:         values[i] = random_value() % 8; break;
+        }
+    }
+}
+
+static double elapsed_ms(const clock_t start) {
+    return 1000.0 * (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Times the sort of 'n_queues' queues of 'length' elements each, either with 'queue__sort' or with qsort
+ * on arrays holding the same elements
+ */
+static double time_sort(uint64_t *values, const size_t n_queues, const size_t length, const int n_rounds, const char use_qsort) {
+    Queue *queues = malloc(sizeof(Queue) * n_queues);
+    elem_t *elems = malloc(sizeof(elem_t) * n_queues * length);
+    double total = 0;
+    clock_t start;
+
+    if (!queues || !elems) {
+        free(queues);
+        free(elems);
+        return -1;
+    }
+
+    for (int r = 0; r < n_rounds; r++) {
+        for (size_t i = 0; i < n_queues; i++) {
+            queues[i] = queue__empty_copy_disabled();
+            for (size_t j = 0; j < length; j++) {
+                queue__enqueue(queues[i], values + i * length + j);
+                elems[i * length + j] = values + i * length + j;
+            }
+        }
+
+        start = clock();
+        for (size_t i = 0; i < n_queues; i++) {
+            if (use_qsort) {
+                qsort(elems + i * length, length, sizeof(elem_t), compare_values);
+            } else {
+                queue__sort(queues[i], compare_values);
+            }
+        }
+        total += elapsed_ms(start);
+
+        for (size_t i = 0; i < n_queues; i++) {
+            queue__free(queues[i]);
+        }
+    }
+
+    free(elems);
+    free(queues);
+    return total / n_rounds;
+}
+
+int main(int argc, char **argv)
+{
+    size_t n_elems = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_N_ELEMS;
+    int n_rounds = argc > 2 ? atoi(argv[2]) : DEFAULT_N_ROUNDS;
+    uint64_t *values = malloc(sizeof(uint64_t) * n_elems);
+
+    if (!values || n_elems < TINY_LENGTH) {
+        printf("allocation failure\n");
+        free(values);
+        return EXIT_FAILURE;
+    }
+
+    printf("sort benchmark: %lu elements, %d rounds\n", n_elems, n_rounds);
+    printf("\t%-24s %12s %12s\n", "distribution", "queue__sort", "qsort");
+
+    srand(42);
+    for (Distribution d = RANDOM; d < N_DISTRIBUTIONS; d++) {
+        fill_values(values, n_elems, d);
+        printf("\t%-24s %9.2f ms %9.2f ms\n", distribution_names[d],
+               time_sort(values, 1, n_elems, n_rounds, false),
+               time_sort(values, 1, n_elems, n_rounds, true));
+    }
+
+    fill_values(values, n_elems, RANDOM);
+    printf("\t%-15s x %-6lu %9.2f ms %9.2f ms\n", "tiny random", n_elems / TINY_LENGTH,
+           time_sort(values, n_elems / TINY_LENGTH, TINY_LENGTH, n_rounds, false),
+           time_sort(values, n_elems / TINY_LENGTH, TINY_LENGTH, n_rounds, true));
+
+    free(values);
+
+    return EXIT_SUCCESS;
+}
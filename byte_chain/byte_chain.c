@@ -0,0 +1,353 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "byte_chain.h"
+
+#ifndef BYTE_CHAIN_MAX_IOV
+#define BYTE_CHAIN_MAX_IOV 64
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+///     BYTE CHAIN STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A segment holds the bytes [start, end) of its data
+ */
+typedef struct Segment
+{
+    struct Segment *next;
+    size_t start;
+    size_t end;
+    unsigned char data[];
+} Segment;
+
+/**
+ * The segments before 'fill' hold bytes, 'fill' is the first one with room and the ones after it are empty.
+ * 'room' counts the bytes that can be written from 'fill' to the tail
+ */
+struct ByteChainSt
+{
+    Segment *head;
+    Segment *tail;
+    Segment *fill;
+    Segment *pool;
+    size_t length;
+    size_t room;
+    size_t segment_size;
+    size_t n_pooled;
+    size_t max_pooled;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     BYTE CHAIN UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+static void release_segment(const ByteChain c, Segment *seg) {
+    if (c->n_pooled < c->max_pooled) {
+        seg->next = c->pool;
+        c->pool = seg;
+        c->n_pooled++;
+    } else {
+        free(seg);
+    }
+}
+
+/**
+ * Links an empty segment, taken from the pool if possible, at the tail of the chain
+ */
+static char push_segment(const ByteChain c) {
+    Segment *seg = c->pool;
+
+    if (seg) {
+        c->pool = seg->next;
+        c->n_pooled--;
+    } else if (!(seg = malloc(sizeof(Segment) + c->segment_size))) {
+        return FAILURE;
+    }
+
+    seg->next = NULL;
+    seg->start = 0;
+    seg->end = 0;
+
+    if (c->tail) {
+        c->tail->next = seg;
+    } else {
+        c->head = seg;
+    }
+    c->tail = seg;
+    if (!c->fill) c->fill = seg;
+    c->room += c->segment_size;
+
+    return SUCCESS;
+}
+
+static char reserve(const ByteChain c, const size_t n) {
+    while (c->room < n) {
+        if (push_segment(c) < 0) return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * Appends n bytes of the reserved room, copying them from data if not NULL
+ */
+static void fill_room(const ByteChain c, const unsigned char *data, size_t n) {
+    size_t k;
+
+    while (n) {
+        k = c->segment_size - c->fill->end;
+        if (k > n) k = n;
+
+        if (data) {
+            memcpy(c->fill->data + c->fill->end, data, k);
+            data += k;
+        }
+        c->fill->end += k;
+        c->length += k;
+        c->room -= k;
+        n -= k;
+
+        if (c->fill->end == c->segment_size) c->fill = c->fill->next;
+    }
+}
+
+/**
+ * Empties the fill segment, its whole size becomes room again
+ */
+static inline void reset_fill(const ByteChain c) {
+    c->room += c->fill->end;
+    c->fill->start = 0;
+    c->fill->end = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     BYTE CHAIN FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+ByteChain byte_chain__empty(const size_t segment_size, const size_t max_pooled) {
+    if (!segment_size || segment_size > SIZE_MAX - sizeof(Segment)) return NULL;
+
+    ByteChain c = malloc(sizeof(struct ByteChainSt));
+    if (!c) return NULL;
+
+    c->head = NULL;
+    c->tail = NULL;
+    c->fill = NULL;
+    c->pool = NULL;
+    c->length = 0;
+    c->room = 0;
+    c->segment_size = segment_size;
+    c->n_pooled = 0;
+    c->max_pooled = max_pooled;
+
+    return c;
+}
+
+inline size_t byte_chain__length(const ByteChain c) {
+    return !c ? SIZE_MAX : c->length;
+}
+
+char byte_chain__append(const ByteChain c, const void *data, const size_t n) {
+    if (!c || (!data && n)) return FAILURE;
+
+    if (reserve(c, n) < 0) return FAILURE;
+
+    fill_room(c, data, n);
+
+    return SUCCESS;
+}
+
+char byte_chain__consume(const ByteChain c, size_t n) {
+    if (!c || n > c->length) return FAILURE;
+
+    Segment *seg;
+    size_t k;
+
+    while (n) {
+        seg = c->head;
+        k = seg->end - seg->start;
+        if (k > n) k = n;
+
+        seg->start += k;
+        c->length -= k;
+        n -= k;
+
+        if (seg->start < seg->end) break;
+
+        if (seg == c->fill) {
+            reset_fill(c);
+        } else {
+            c->head = seg->next;
+            if (!c->head) c->tail = NULL;
+            release_segment(c, seg);
+        }
+    }
+
+    return SUCCESS;
+}
+
+size_t byte_chain__copy(const ByteChain c, void *dst, const size_t n) {
+    if (!c || (!dst && n)) return SIZE_MAX;
+
+    unsigned char *out = dst;
+    size_t copied = 0, k;
+
+    for (Segment *seg = c->head; seg && copied < n; seg = seg->next) {
+        k = seg->end - seg->start;
+        if (k > n - copied) k = n - copied;
+        memcpy(out + copied, seg->data + seg->start, k);
+        copied += k;
+    }
+
+    return copied;
+}
+
+const void *byte_chain__peek_contiguous(const ByteChain c, const size_t n) {
+    if (!c || !n || n > c->length || n > c->segment_size) return NULL;
+
+    Segment *head = c->head;
+    Segment *next;
+    size_t k;
+
+    if (head->end - head->start >= n) return head->data + head->start;
+
+    /* the bytes span several segments, the head is then not the fill segment and its room is unused */
+    if (head->start + n > c->segment_size) {
+        memmove(head->data, head->data + head->start, head->end - head->start);
+        head->end -= head->start;
+        head->start = 0;
+    }
+
+    while (head->end - head->start < n) {
+        next = head->next;
+        k = next->end - next->start;
+        if (k > n - (head->end - head->start)) k = n - (head->end - head->start);
+
+        memcpy(head->data + head->end, next->data + next->start, k);
+        head->end += k;
+        next->start += k;
+
+        if (next->start < next->end) continue;
+
+        if (next == c->fill) {
+            reset_fill(c);
+        } else {
+            head->next = next->next;
+            if (c->tail == next) c->tail = head;
+            release_segment(c, next);
+        }
+    }
+
+    return head->data + head->start;
+}
+
+size_t byte_chain__data_iovecs(const ByteChain c, struct iovec *iov, const size_t max_iov) {
+    if (!c || (!iov && max_iov)) return SIZE_MAX;
+
+    size_t count = 0;
+
+    for (Segment *seg = c->head; seg && count < max_iov; seg = seg->next) {
+        if (seg->end > seg->start) {
+            iov[count].iov_base = seg->data + seg->start;
+            iov[count].iov_len = seg->end - seg->start;
+            count++;
+        }
+        if (seg == c->fill) break;
+    }
+
+    return count;
+}
+
+size_t byte_chain__space_iovecs(const ByteChain c, const size_t n, struct iovec *iov, const size_t max_iov) {
+    if (!c || (!iov && max_iov)) return SIZE_MAX;
+
+    if (reserve(c, n) < 0) return SIZE_MAX;
+
+    size_t count = 0, covered = 0;
+
+    for (Segment *seg = c->fill; seg && covered < n && count < max_iov; seg = seg->next) {
+        iov[count].iov_base = seg->data + seg->end;
+        iov[count].iov_len = c->segment_size - seg->end;
+        covered += iov[count].iov_len;
+        count++;
+    }
+
+    return count;
+}
+
+char byte_chain__commit(const ByteChain c, const size_t n) {
+    if (!c || n > c->room) return FAILURE;
+
+    fill_room(c, NULL, n);
+
+    return SUCCESS;
+}
+
+ssize_t byte_chain__writev(const ByteChain c, const int fd) {
+    struct iovec iov[BYTE_CHAIN_MAX_IOV];
+    if (!c) return FAILURE;
+
+    size_t count = byte_chain__data_iovecs(c, iov, BYTE_CHAIN_MAX_IOV);
+    if (!count) return 0;
+
+    ssize_t res = writev(fd, iov, (int)count);
+    if (res > 0) byte_chain__consume(c, (size_t)res);
+
+    return res;
+}
+
+ssize_t byte_chain__readv(const ByteChain c, const int fd, const size_t n) {
+    struct iovec iov[BYTE_CHAIN_MAX_IOV];
+    if (!c) return FAILURE;
+    if (!n) return 0;
+
+    size_t count = byte_chain__space_iovecs(c, n, iov, BYTE_CHAIN_MAX_IOV);
+    if (count == SIZE_MAX) return FAILURE;
+
+    /* the last segment may hold more room than requested */
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (iov[i].iov_len > n - total) iov[i].iov_len = n - total;
+        total += iov[i].iov_len;
+    }
+
+    ssize_t res = readv(fd, iov, (int)count);
+    if (res > 0) byte_chain__commit(c, (size_t)res);
+
+    return res;
+}
+
+void byte_chain__clear(const ByteChain c) {
+    if (!c) return;
+
+    Segment *next;
+    for (Segment *seg = c->head; seg; seg = next) {
+        next = seg->next;
+        release_segment(c, seg);
+    }
+
+    c->head = NULL;
+    c->tail = NULL;
+    c->fill = NULL;
+    c->length = 0;
+    c->room = 0;
+}
+
+void byte_chain__free(const ByteChain c) {
+    if (!c) return;
+
+    Segment *next;
+    c->max_pooled = 0;
+    byte_chain__clear(c);
+
+    for (Segment *seg = c->pool; seg; seg = next) {
+        next = seg->next;
+        free(seg);
+    }
+    free(c);
+}
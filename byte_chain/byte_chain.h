@@ -0,0 +1,161 @@
+#ifndef __BYTE_CHAIN_H__
+#define __BYTE_CHAIN_H__
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a FIFO byte stream buffer stored in a chain of fixed size segments
+ *
+ * Notes :
+ * 1) Bytes are appended at the back of the chain and consumed from its front. Segments emptied by a consume are
+ * kept in a pool of at most 'max_pooled' segments and reused by the next appends instead of being freed.
+ *
+ * 2) The segments are exposed as iovec arrays so that the bytes are given to 'writev', and read by 'readv',
+ * without going through an intermediate buffer. 'byte_chain__space_iovecs' reserves room at the back of the chain
+ * and 'byte_chain__commit' appends the bytes written into it. 'byte_chain__writev' and 'byte_chain__readv' give
+ * at most BYTE_CHAIN_MAX_IOV segments to a single system call.
+ *
+ * 3) The pointers given by the iovec and peek functions stay valid until the next modification of the chain.
+ */
+typedef struct ByteChainSt * ByteChain;
+
+
+/**
+ * @brief create an empty byte chain
+ * @note complexity: O(1)
+ * @param segment_size byte size of a segment, not 0
+ * @param max_pooled maximum number of free segments kept for reuse
+ * @return a pointer to the chain on success, NULL on failure
+ */
+ByteChain byte_chain__empty(const size_t segment_size, const size_t max_pooled);
+
+
+/**
+ * @brief number of bytes in the chain
+ * @note complexity: O(1)
+ * @param c the chain
+ * @return the number of bytes on success, SIZE_MAX on failure
+ */
+size_t byte_chain__length(const ByteChain c);
+
+
+/**
+ * @brief appends bytes at the back of the chain
+ * @note complexity: O(n)
+ * @param c the chain
+ * @param data the bytes
+ * @param n number of bytes
+ * @return 0 on success, -1 on failure
+ */
+char byte_chain__append(const ByteChain c, const void *data, const size_t n);
+
+
+/**
+ * @brief removes bytes from the front of the chain
+ * @note complexity: O(number of segments released)
+ * @param c the chain
+ * @param n number of bytes, not greater than the length of the chain
+ * @return 0 on success, -1 on failure
+ */
+char byte_chain__consume(const ByteChain c, const size_t n);
+
+
+/**
+ * @brief copies bytes from the front of the chain without removing them
+ * @note complexity: O(n)
+ * @param c the chain
+ * @param dst the destination buffer
+ * @param n maximum number of bytes to copy
+ * @return the number of bytes copied on success, SIZE_MAX on failure
+ */
+size_t byte_chain__copy(const ByteChain c, void *dst, const size_t n);
+
+
+/**
+ * @brief contiguous view of the first bytes of the chain
+ * @details when the bytes span several segments, they are first gathered in the front segment
+ * @note complexity: O(1) if the bytes are in the front segment, O(n) otherwise
+ * @param c the chain
+ * @param n number of bytes, not 0 and not greater than the length of the chain nor the segment size
+ * @return a pointer to the bytes on success, NULL on failure
+ */
+const void *byte_chain__peek_contiguous(const ByteChain c, const size_t n);
+
+
+/**
+ * @brief describes the bytes of the chain, from its front, as an iovec array
+ * @note complexity: O(max_iov)
+ * @param c the chain
+ * @param iov the iovec array
+ * @param max_iov size of the iovec array
+ * @return the number of iovec filled on success, SIZE_MAX on failure
+ */
+size_t byte_chain__data_iovecs(const ByteChain c, struct iovec *iov, const size_t max_iov);
+
+
+/**
+ * @brief reserves room for at least n bytes at the back of the chain and describes it as an iovec array
+ * @details the room is filled in order, the bytes written into it are appended by 'byte_chain__commit'
+ * @note complexity: O(n / segment_size + max_iov)
+ * @param c the chain
+ * @param n number of bytes to reserve
+ * @param iov the iovec array
+ * @param max_iov size of the iovec array
+ * @return the number of iovec filled on success, SIZE_MAX on failure
+ */
+size_t byte_chain__space_iovecs(const ByteChain c, const size_t n, struct iovec *iov, const size_t max_iov);
+
+
+/**
+ * @brief appends the first n bytes written into the reserved room
+ * @note complexity: O(n / segment_size)
+ * @param c the chain
+ * @param n number of bytes, not greater than the reserved room
+ * @return 0 on success, -1 on failure
+ */
+char byte_chain__commit(const ByteChain c, const size_t n);
+
+
+/**
+ * @brief writes bytes of the chain to the file descriptor with a single 'writev' and consumes them
+ * @note complexity: O(BYTE_CHAIN_MAX_IOV) plus the system call
+ * @param c the chain
+ * @param fd the file descriptor
+ * @return the number of bytes written, -1 on failure
+ */
+ssize_t byte_chain__writev(const ByteChain c, const int fd);
+
+
+/**
+ * @brief reads at most n bytes from the file descriptor with a single 'readv' and appends them
+ * @note complexity: O(n / segment_size) plus the system call
+ * @param c the chain
+ * @param fd the file descriptor
+ * @param n maximum number of bytes to read
+ * @return the number of bytes read, 0 at the end of the file, -1 on failure
+ */
+ssize_t byte_chain__readv(const ByteChain c, const int fd, const size_t n);
+
+
+/**
+ * @brief removes all bytes of the chain, the segments are kept in the pool up to its size
+ * @note complexity: O(number of segments)
+ * @param c the chain
+ */
+void byte_chain__clear(const ByteChain c);
+
+
+/**
+ * @brief frees all allocated memory used by the chain
+ * @note complexity: O(number of segments)
+ * @param c the chain
+ */
+void byte_chain__free(const ByteChain c);
+
+
+#endif
@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coalescing_queue.h"
+#include "../common/hash_index.h"
+
+#define DEFAULT_COALESCING_CAPACITY 4
+
+///////////////////////////////////////////////////////////////////////////////
+///     COALESCING QUEUE STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+struct CoalescingQueueSt
+{
+    elem_t *elems;
+    size_t front;
+    size_t back;
+    size_t length;
+    size_t capacity;
+    size_t head_seq;
+    HashIndex index;
+    bin_applying_func_t merge;
+    void *user_data;
+    delete_operator_t operator_delete;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     COALESCING QUEUE MACRO UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Sequence number of the element at position i, sequence numbers survive the shifts of the buffer
+ */
+#define SEQ(__ptr, __i) \
+    ((__ptr)->head_seq + (__i) - (__ptr)->front)
+
+/**
+ * Position of the element with the given sequence number
+ */
+#define POSITION(__ptr, __seq) \
+    ((__ptr)->front + (__seq) - (__ptr)->head_seq)
+
+/**
+ * Macro to resize the elements array
+ */
+#define COALESCING_RESIZE(__ptr, __new_capacity) \
+({ \
+    int __result_res = FAILURE; \
+    elem_t *__realloc_res = realloc((__ptr)->elems, sizeof(elem_t) * (__new_capacity)); \
+    if (__realloc_res) { \
+        (__ptr)->elems = __realloc_res; \
+        (__ptr)->capacity = (__new_capacity); \
+        __result_res = SUCCESS; \
+    } \
+    (char)__result_res; \
+})
+
+/**
+ * Macro to shift all elements to the left of the elements array
+ */
+#define COALESCING_SHIFT(__ptr) \
+    memmove((__ptr)->elems, (__ptr)->elems + (__ptr)->front, sizeof(elem_t) * (__ptr)->length); \
+    (__ptr)->front = 0; \
+    (__ptr)->back = (__ptr)->length
+
+static inline void drop(const CoalescingQueue q, const elem_t elem) {
+    if (q->operator_delete) q->operator_delete(elem);
+}
+
+/**
+ * Replaces the pending element at position i by the new one, or by their merge
+ */
+static void coalesce(const CoalescingQueue q, const size_t i, const elem_t element) {
+    elem_t pending = q->elems[i];
+    elem_t res = q->merge ? q->merge(pending, element, q->user_data) : element;
+
+    if (res != pending) {
+        hash_index__remove(q->index, pending, SEQ(q, i));
+        hash_index__insert(q->index, res, SEQ(q, i));
+        q->elems[i] = res;
+        drop(q, pending);
+    }
+    if (res != element) drop(q, element);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     COALESCING QUEUE FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+CoalescingQueue coalescing_queue__empty(const key_func_t hash, const compare_func_t match, const bin_applying_func_t merge,
+                                        void *user_data, const delete_operator_t delete_op) {
+    if (!hash || !match) return NULL;
+
+    CoalescingQueue q = malloc(sizeof(struct CoalescingQueueSt));
+    if (!q) return NULL;
+
+    q->elems = malloc(sizeof(elem_t) * DEFAULT_COALESCING_CAPACITY);
+    q->index = hash_index__empty(hash, match);
+    if (!q->elems || !q->index) {
+        free(q->elems);
+        hash_index__free(q->index);
+        free(q);
+        return NULL;
+    }
+
+    q->front = 0;
+    q->back = 0;
+    q->length = 0;
+    q->capacity = DEFAULT_COALESCING_CAPACITY;
+    q->head_seq = 0;
+    q->merge = merge;
+    q->user_data = user_data;
+    q->operator_delete = delete_op;
+
+    return q;
+}
+
+inline char coalescing_queue__is_empty(const CoalescingQueue q) {
+    return !q ? FAILURE : !q->length;
+}
+
+inline size_t coalescing_queue__length(const CoalescingQueue q) {
+    return !q ? SIZE_MAX : q->length;
+}
+
+char coalescing_queue__enqueue(const CoalescingQueue q, const elem_t element) {
+    if (!q || !element) return FAILURE;
+
+    size_t seq = hash_index__find(q->index, element);
+    if (seq != SIZE_MAX) {
+        coalesce(q, POSITION(q, seq), element);
+        return SUCCESS;
+    }
+
+    if (hash_index__reserve(q->index, q->length + 1) < 0) return FAILURE;
+
+    if (q->back == q->capacity) {
+        if (q->front >= q->capacity>>1) {
+            COALESCING_SHIFT(q);
+        } else if (COALESCING_RESIZE(q, q->capacity<<1) < 0) {
+            return FAILURE;
+        }
+    }
+
+    q->elems[q->back] = element;
+    hash_index__insert(q->index, element, SEQ(q, q->back));
+    q->back++;
+    q->length++;
+
+    return SUCCESS;
+}
+
+char coalescing_queue__dequeue(const CoalescingQueue q, elem_t *front) {
+    if (!q || !q->length) return FAILURE;
+
+    elem_t elem = q->elems[q->front];
+    hash_index__remove(q->index, elem, q->head_seq);
+
+    q->front++;
+    q->head_seq++;
+    q->length--;
+    if (!q->length) {
+        q->front = 0;
+        q->back = 0;
+    }
+
+    if (front) {
+        *front = elem;
+    } else {
+        drop(q, elem);
+    }
+
+    return SUCCESS;
+}
+
+char coalescing_queue__peek(const CoalescingQueue q, elem_t *front) {
+    if (!q || !q->length || !front) return FAILURE;
+
+    *front = q->elems[q->front];
+
+    return SUCCESS;
+}
+
+char coalescing_queue__find(const CoalescingQueue q, const elem_t key, elem_t *pending) {
+    if (!q || !key || !pending) return FAILURE;
+
+    size_t seq = hash_index__find(q->index, key);
+    if (seq == SIZE_MAX) return FAILURE;
+
+    *pending = q->elems[POSITION(q, seq)];
+
+    return SUCCESS;
+}
+
+void coalescing_queue__clear(const CoalescingQueue q) {
+    if (!q) return;
+
+    for (size_t i = q->front; i < q->back; i++) {
+        drop(q, q->elems[i]);
+    }
+
+    hash_index__clear(q->index);
+    q->front = 0;
+    q->back = 0;
+    q->length = 0;
+    COALESCING_RESIZE(q, DEFAULT_COALESCING_CAPACITY);
+}
+
+void coalescing_queue__free(const CoalescingQueue q) {
+    if (!q) return;
+
+    for (size_t i = q->front; i < q->back; i++) {
+        drop(q, q->elems[i]);
+    }
+
+    hash_index__free(q->index);
+    free(q->elems);
+    free(q);
+}
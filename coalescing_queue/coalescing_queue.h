@@ -0,0 +1,121 @@
+#ifndef __COALESCING_QUEUE_H__
+#define __COALESCING_QUEUE_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a FIFO queue coalescing the pending elements with the same key
+ *
+ * Notes :
+ * 1) The key of an element is defined by the hash and match functions, which receive elements:
+ * two elements have the same key when the match function returns 1.
+ *
+ * 2) Enqueuing an element whose key is already pending does not add an entry: the pending element is
+ * replaced, or merged with the new one by the merge function, and keeps its position in the queue.
+ * A burst of updates of the same key therefore costs a single dequeue.
+ *
+ * 3) The merge function receives the pending element, the new one and the user data, and returns the merged
+ * element, which must have the same key. It can return one of its arguments.
+ *
+ * 4) The queue owns its elements: the replaced ones, and the merged ones not returned by the merge function,
+ * are deleted with the delete operator, if any. NULL elements can not be enqueued.
+ */
+typedef struct CoalescingQueueSt * CoalescingQueue;
+
+
+/**
+ * @brief create an empty coalescing queue
+ * @note complexity: O(1)
+ * @param hash the hash function of the keys
+ * @param match the match function of the keys
+ * @param merge the merge function, NULL to replace the pending element
+ * @param user_data the user data given to the merge function
+ * @param delete_op the delete operator, NULL if the elements are not owned
+ * @return a pointer to the queue on success, NULL on failure
+ */
+CoalescingQueue coalescing_queue__empty(const key_func_t hash, const compare_func_t match, const bin_applying_func_t merge,
+                                        void *user_data, const delete_operator_t delete_op);
+
+
+/**
+ * @brief checks if the queue is empty
+ * @note complexity: O(1)
+ * @param q the queue
+ * @return 1 if the queue is empty, 0 if not, -1 on failure
+ */
+char coalescing_queue__is_empty(const CoalescingQueue q);
+
+
+/**
+ * @brief number of pending elements, one per key
+ * @note complexity: O(1)
+ * @param q the queue
+ * @return the number of elements on success, SIZE_MAX on failure
+ */
+size_t coalescing_queue__length(const CoalescingQueue q);
+
+
+/**
+ * @brief enqueues an element, or coalesces it with the pending element of the same key
+ * @note complexity: O(1) amortized
+ * @param q the queue
+ * @param element the element, not NULL
+ * @return 0 on success, -1 on failure
+ */
+char coalescing_queue__enqueue(const CoalescingQueue q, const elem_t element);
+
+
+/**
+ * @brief removes the oldest pending element of the queue
+ * @details the element is stored in 'front' variable, which takes its ownership, it is deleted if 'front' is NULL
+ * @note complexity: O(1)
+ * @param q the queue
+ * @param front pointer to storage variable, can be NULL
+ * @return 0 on success, -1 on failure
+ */
+char coalescing_queue__dequeue(const CoalescingQueue q, elem_t *front);
+
+
+/**
+ * @brief retrieve the oldest pending element of the queue without removing it
+ * @details the element still belongs to the queue
+ * @note complexity: O(1)
+ * @param q the queue
+ * @param front pointer to storage variable
+ * @return 0 on success, -1 on failure
+ */
+char coalescing_queue__peek(const CoalescingQueue q, elem_t *front);
+
+
+/**
+ * @brief retrieve the pending element with the key of the given one
+ * @details the element still belongs to the queue
+ * @note complexity: O(1) expected
+ * @param q the queue
+ * @param key an element holding the key
+ * @param pending pointer to storage variable
+ * @return 0 if an element with this key is pending, -1 if not or on failure
+ */
+char coalescing_queue__find(const CoalescingQueue q, const elem_t key, elem_t *pending);
+
+
+/**
+ * @brief removes all elements of the queue
+ * @note complexity: O(n)
+ * @param q the queue
+ */
+void coalescing_queue__clear(const CoalescingQueue q);
+
+
+/**
+ * @brief frees all allocated memory used by the queue and deletes its elements
+ * @note complexity: O(n)
+ * @param q the queue
+ */
+void coalescing_queue__free(const CoalescingQueue q);
+
+
+#endif
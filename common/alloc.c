@@ -0,0 +1,53 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "alloc.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///     ALLOC UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+#if ELEMS_ALIGNMENT > 0
+static void *aligned_block(const size_t alignment, const size_t size) {
+    void *res;
+    return posix_memalign(&res, alignment, size ? size : alignment) ? NULL : res;
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+///     ALLOC FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+elem_t *alloc__elems(const size_t n_elems) {
+#if ELEMS_ALIGNMENT > 0
+    return aligned_block(ELEMS_ALIGNMENT, sizeof(elem_t) * n_elems);
+#else
+    return malloc(sizeof(elem_t) * n_elems);
+#endif
+}
+
+elem_t *alloc__resize_elems(elem_t *elems, const size_t old_n_elems, const size_t new_n_elems) {
+#if ELEMS_ALIGNMENT > 0
+    elem_t *res = aligned_block(ELEMS_ALIGNMENT, sizeof(elem_t) * new_n_elems);
+    if (!res) return NULL;
+
+    if (elems) {
+        memcpy(res, elems, sizeof(elem_t) * (old_n_elems < new_n_elems ? old_n_elems : new_n_elems));
+        free(elems);
+    }
+
+    return res;
+#else
+    return realloc(elems, sizeof(elem_t) * new_n_elems);
+#endif
+}
+
+void *alloc__control(const size_t size) {
+#if ELEMS_ALIGNMENT > 0
+    return aligned_block(CACHE_LINE_SIZE, size);
+#else
+    return malloc(size);
+#endif
+}
@@ -0,0 +1,67 @@
+#ifndef __ALLOC_H__
+#define __ALLOC_H__
+
+#include <stddef.h>
+
+#include "defs.h"
+
+
+/**
+ * Allocation of the element buffers and control blocks of the vector based ADTs
+ *
+ * Notes :
+ * 1) ELEMS_ALIGNMENT is the alignment in bytes of the element buffers, a power of two multiple of sizeof(void *)
+ * such as the cache line size (64) or the page size (4096). 0 keeps the alignment given by malloc.
+ *
+ * 2) When ELEMS_ALIGNMENT is set, the control blocks are aligned and padded to CACHE_LINE_SIZE so that
+ * containers owned by different threads never share a cache line.
+ *
+ * 3) Every block returned here is released with free.
+ */
+#ifndef ELEMS_ALIGNMENT
+#define ELEMS_ALIGNMENT 0
+#endif
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+#if ELEMS_ALIGNMENT > 0
+#define CACHE_ALIGNED __attribute__((aligned(CACHE_LINE_SIZE)))
+#else
+#define CACHE_ALIGNED
+#endif
+
+
+/**
+ * @brief allocates a buffer of elements aligned on ELEMS_ALIGNMENT
+ * @note complexity: O(1)
+ * @param n_elems number of elements
+ * @return a pointer to the buffer on success, NULL on failure
+ */
+elem_t *alloc__elems(const size_t n_elems);
+
+
+/**
+ * @brief resizes a buffer of elements, keeping its alignment
+ * @details the first min(old_n_elems, new_n_elems) elements are kept. The buffer is moved to a new aligned
+ * block when ELEMS_ALIGNMENT is set, and resized with realloc otherwise. On failure the buffer is left untouched
+ * @note complexity: O(min(old_n_elems, new_n_elems))
+ * @param elems the buffer
+ * @param old_n_elems current number of elements of the buffer
+ * @param new_n_elems new number of elements of the buffer
+ * @return a pointer to the resized buffer on success, NULL on failure
+ */
+elem_t *alloc__resize_elems(elem_t *elems, const size_t old_n_elems, const size_t new_n_elems);
+
+
+/**
+ * @brief allocates a control block, aligned and padded to CACHE_LINE_SIZE when ELEMS_ALIGNMENT is set
+ * @note complexity: O(1)
+ * @param size size of the control block, a multiple of CACHE_LINE_SIZE for CACHE_ALIGNED structures
+ * @return a pointer to the block on success, NULL on failure
+ */
+void *alloc__control(const size_t size);
+
+
+#endif
@@ -2,6 +2,7 @@
 #define __DEFS_H__
 
 #include <stdint.h>
+#include <stdio.h>
 
 #ifndef SUCCESS
 #define SUCCESS 0
@@ -51,6 +52,26 @@ typedef char (*filter_func_t)(const void *, void *);
  */
 typedef int (*compare_func_t)(const void *, const void *);
 
+/**
+ * Function pointer for integer sort key extraction
+ */
+typedef uint64_t (*key_func_t)(const void *);
+
+/**
+ * Function pointer for sort key extraction, the key is written in the buffer given as second argument
+ */
+typedef void (*key_extract_func_t)(const void *, void *);
+
+/**
+ * Function pointer for element serialization, writes the element to the stream and returns 0 on success, -1 on failure
+ */
+typedef char (*serialize_func_t)(const void *, FILE *);
+
+/**
+ * Function pointer for element deserialization, returns the next element read from the stream or NULL at its end
+ */
+typedef elem_t (*deserialize_func_t)(FILE *);
+
 /**
  * Function pointer for element print
  */
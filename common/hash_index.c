@@ -0,0 +1,299 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash_index.h"
+
+#define DEFAULT_INDEX_CAPACITY 16
+
+///////////////////////////////////////////////////////////////////////////////
+///     HASH INDEX STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Entry of an element of the index, shared by all the stored elements matching it.
+ * Holds the smallest and largest of their sequence numbers, the ends of their chain
+ */
+typedef struct
+{
+    uint64_t hash;
+    elem_t elem;
+    size_t first;
+    size_t last;
+} IndexGroup;
+
+/**
+ * Entry of a sequence number, linked to the previous and next sequence numbers of the matching elements
+ */
+typedef struct
+{
+    uint64_t hash;
+    elem_t elem;
+    size_t seq;
+    size_t prev;
+    size_t next;
+} IndexNode;
+
+struct HashIndexSt
+{
+    IndexGroup *groups;
+    IndexNode *nodes;
+    size_t capacity;
+    size_t length;
+    key_func_t hash;
+    compare_func_t match;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     HASH INDEX UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+#define NO_SEQ SIZE_MAX
+
+/**
+ * Spreads the user hash over the low bits used as slot, user hashes are often identities
+ */
+static inline uint64_t mix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+#define GROUP_HOME(__entry) \
+    ((size_t)(__entry).hash)
+
+#define NODE_HOME(__entry) \
+    ((size_t)mix((__entry).seq))
+
+/**
+ * Empties the slot i of a table by backward shift of the following entries which are not at their home slot
+ */
+#define ERASE(__table, __i, __mask, __home) do { \
+    size_t __j = (__i); \
+    size_t __home_j; \
+    for (;;) { \
+        __j = (__j + 1) & (__mask); \
+        if (!(__table)[__j].elem) break; \
+        __home_j = __home((__table)[__j]) & (__mask); \
+        if (((__j - __home_j) & (__mask)) >= ((__j - (__i)) & (__mask))) { \
+            (__table)[__i] = (__table)[__j]; \
+            (__i) = __j; \
+        } \
+    } \
+    (__table)[__i].elem = NULL; \
+} while (false)
+
+/**
+ * Slot of the group matching the element, or the empty slot ending its probe sequence
+ */
+static inline size_t group_slot(const HashIndex h, const uint64_t hash, const elem_t elem) {
+    size_t mask = h->capacity - 1;
+    size_t i = (size_t)hash & mask;
+
+    while (h->groups[i].elem && !(h->groups[i].hash == hash && h->match(h->groups[i].elem, elem))) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+/**
+ * Slot of the node of the sequence number, or the empty slot ending its probe sequence
+ */
+static inline size_t node_slot(const HashIndex h, const size_t seq) {
+    size_t mask = h->capacity - 1;
+    size_t i = (size_t)mix(seq) & mask;
+
+    while (h->nodes[i].elem && h->nodes[i].seq != seq) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static char rehash(const HashIndex h, const size_t capacity) {
+    IndexGroup *groups = calloc(capacity, sizeof(IndexGroup));
+    IndexNode *nodes = calloc(capacity, sizeof(IndexNode));
+    if (!groups || !nodes) {
+        free(groups);
+        free(nodes);
+        return FAILURE;
+    }
+
+    IndexGroup *old_groups = h->groups;
+    IndexNode *old_nodes = h->nodes;
+    size_t old_capacity = h->capacity;
+    size_t mask = capacity - 1;
+    size_t j;
+
+    h->groups = groups;
+    h->nodes = nodes;
+    h->capacity = capacity;
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_groups[i].elem) {
+            j = GROUP_HOME(old_groups[i]) & mask;
+            while (groups[j].elem) {
+                j = (j + 1) & mask;
+            }
+            groups[j] = old_groups[i];
+        }
+        if (old_nodes[i].elem) {
+            j = NODE_HOME(old_nodes[i]) & mask;
+            while (nodes[j].elem) {
+                j = (j + 1) & mask;
+            }
+            nodes[j] = old_nodes[i];
+        }
+    }
+
+    free(old_groups);
+    free(old_nodes);
+    return SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     HASH INDEX FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+HashIndex hash_index__empty(const key_func_t hash, const compare_func_t match) {
+    if (!hash || !match) return NULL;
+
+    HashIndex h = malloc(sizeof(struct HashIndexSt));
+    if (!h) return NULL;
+
+    h->groups = calloc(DEFAULT_INDEX_CAPACITY, sizeof(IndexGroup));
+    h->nodes = calloc(DEFAULT_INDEX_CAPACITY, sizeof(IndexNode));
+    if (!h->groups || !h->nodes) {
+        free(h->groups);
+        free(h->nodes);
+        free(h);
+        return NULL;
+    }
+
+    h->capacity = DEFAULT_INDEX_CAPACITY;
+    h->length = 0;
+    h->hash = hash;
+    h->match = match;
+
+    return h;
+}
+
+inline key_func_t hash_index__hash(const HashIndex h) {
+    return h ? h->hash : NULL;
+}
+
+inline compare_func_t hash_index__match(const HashIndex h) {
+    return h ? h->match : NULL;
+}
+
+char hash_index__reserve(const HashIndex h, const size_t n) {
+    if (!h) return FAILURE;
+
+    /* load factor kept under 3/4 */
+    size_t capacity = h->capacity;
+    while (n >= capacity - (capacity>>2)) {
+        if (capacity > SIZE_MAX / 2 / sizeof(IndexNode)) return FAILURE;
+        capacity <<= 1;
+    }
+
+    return capacity == h->capacity ? SUCCESS : rehash(h, capacity);
+}
+
+void hash_index__insert(const HashIndex h, const elem_t elem, const size_t seq) {
+    if (!h || !elem) return;
+
+    uint64_t hash = mix(h->hash(elem));
+    IndexNode node = {hash, elem, seq, NO_SEQ, NO_SEQ};
+    IndexGroup *group = h->groups + group_slot(h, hash, elem);
+
+    if (!group->elem) {
+        group->hash = hash;
+        group->elem = elem;
+        group->first = seq;
+        group->last = seq;
+    } else if (seq > group->last) {
+        h->nodes[node_slot(h, group->last)].next = seq;
+        node.prev = group->last;
+        group->last = seq;
+    } else {
+        /* out of order sequence number, its place is searched back from the end of the chain */
+        size_t prev = group->last;
+        while (prev != NO_SEQ && prev > seq) {
+            prev = h->nodes[node_slot(h, prev)].prev;
+        }
+        if (prev == NO_SEQ) {
+            node.next = group->first;
+            group->first = seq;
+            group->elem = elem;
+        } else {
+            IndexNode *p_prev = h->nodes + node_slot(h, prev);
+            node.next = p_prev->next;
+            p_prev->next = seq;
+        }
+        node.prev = prev;
+        h->nodes[node_slot(h, node.next)].prev = seq;
+    }
+
+    h->nodes[node_slot(h, seq)] = node;
+    h->length++;
+}
+
+void hash_index__remove(const HashIndex h, const elem_t elem, const size_t seq) {
+    if (!h || !elem) return;
+
+    size_t mask = h->capacity - 1;
+    size_t i = node_slot(h, seq);
+    IndexNode node = h->nodes[i];
+    if (!node.elem) return;
+
+    if (node.prev != NO_SEQ) {
+        h->nodes[node_slot(h, node.prev)].next = node.next;
+    }
+    if (node.next != NO_SEQ) {
+        h->nodes[node_slot(h, node.next)].prev = node.prev;
+    }
+
+    /* the group is only updated when an end of its chain is removed */
+    if (node.prev == NO_SEQ || node.next == NO_SEQ) {
+        size_t g = (size_t)node.hash & mask;
+        while (h->groups[g].elem
+               && !(h->groups[g].hash == node.hash && (h->groups[g].first == seq || h->groups[g].last == seq))) {
+            g = (g + 1) & mask;
+        }
+
+        if (node.prev == NO_SEQ && node.next == NO_SEQ) {
+            ERASE(h->groups, g, mask, GROUP_HOME);
+        } else if (node.prev == NO_SEQ) {
+            h->groups[g].first = node.next;
+            h->groups[g].elem = h->nodes[node_slot(h, node.next)].elem;
+        } else {
+            h->groups[g].last = node.prev;
+        }
+    }
+
+    ERASE(h->nodes, i, mask, NODE_HOME);
+    h->length--;
+}
+
+size_t hash_index__find(const HashIndex h, const elem_t elem) {
+    if (!h || !elem) return SIZE_MAX;
+
+    size_t g = group_slot(h, mix(h->hash(elem)), elem);
+
+    return h->groups[g].elem ? h->groups[g].first : SIZE_MAX;
+}
+
+void hash_index__clear(const HashIndex h) {
+    if (!h) return;
+
+    memset(h->groups, 0, sizeof(IndexGroup) * h->capacity);
+    memset(h->nodes, 0, sizeof(IndexNode) * h->capacity);
+    h->length = 0;
+}
+
+void hash_index__free(const HashIndex h) {
+    if (!h) return;
+
+    free(h->groups);
+    free(h->nodes);
+    free(h);
+}
@@ -0,0 +1,110 @@
+#ifndef __HASH_INDEX_H__
+#define __HASH_INDEX_H__
+
+#include <stddef.h>
+
+#include "defs.h"
+
+
+/**
+ * Secondary hash index mapping elements to their sequence numbers in an ADT
+ *
+ * Notes :
+ * 1) The index is a multimap: every stored element comes with a sequence number, the owner of the index
+ * gives each stored element a distinct sequence number and translates it back to a position. Matching elements
+ * share one entry holding the chain of their sequence numbers in ascending order, so that duplicates cost no probing.
+ *
+ * 2) Elements are hashed with the user hash function and compared with the user match function,
+ * which returns 1 if both elements are equal. NULL elements are never indexed.
+ *
+ * 3) The entries of the elements and of the sequence numbers are kept in two tables using linear probing with
+ * backward shift deletion, so removals leave no tombstones.
+ */
+typedef struct HashIndexSt * HashIndex;
+
+
+/**
+ * @brief create an empty index
+ * @note complexity: O(1)
+ * @param hash the hash function, receives an element
+ * @param match the match function
+ * @return a pointer to the index on success, NULL on failure
+ */
+HashIndex hash_index__empty(const key_func_t hash, const compare_func_t match);
+
+
+/**
+ * @brief hash function of the index
+ * @note complexity: O(1)
+ * @param h the index
+ * @return the hash function on success, NULL on failure
+ */
+key_func_t hash_index__hash(const HashIndex h);
+
+
+/**
+ * @brief match function of the index
+ * @note complexity: O(1)
+ * @param h the index
+ * @return the match function on success, NULL on failure
+ */
+compare_func_t hash_index__match(const HashIndex h);
+
+
+/**
+ * @brief grows the index so that it holds n entries without allocating
+ * @note complexity: O(1) amortized, O(n) when the index grows
+ * @param h the index
+ * @param n number of entries
+ * @return 0 on success, -1 on failure
+ */
+char hash_index__reserve(const HashIndex h, const size_t n);
+
+
+/**
+ * @brief adds an entry, room for it must have been reserved
+ * @note complexity: O(1) expected, O(k) if the sequence number is smaller than those of the k last matching elements
+ * @param h the index
+ * @param elem the element, ignored if NULL
+ * @param seq the sequence number of the element
+ */
+void hash_index__insert(const HashIndex h, const elem_t elem, const size_t seq);
+
+
+/**
+ * @brief removes the entry of the element with the given sequence number
+ * @note complexity: O(1) expected
+ * @param h the index
+ * @param elem the element, ignored if NULL
+ * @param seq the sequence number of the element
+ */
+void hash_index__remove(const HashIndex h, const elem_t elem, const size_t seq);
+
+
+/**
+ * @brief smallest sequence number of the elements matching the given one
+ * @note complexity: O(1) expected
+ * @param h the index
+ * @param elem the element
+ * @return the sequence number if found, SIZE_MAX otherwise or on failure
+ */
+size_t hash_index__find(const HashIndex h, const elem_t elem);
+
+
+/**
+ * @brief removes all entries, the capacity is kept
+ * @note complexity: O(capacity)
+ * @param h the index
+ */
+void hash_index__clear(const HashIndex h);
+
+
+/**
+ * @brief frees all allocated memory used by the index, the elements are not deleted
+ * @note complexity: O(1)
+ * @param h the index
+ */
+void hash_index__free(const HashIndex h);
+
+
+#endif
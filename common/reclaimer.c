@@ -0,0 +1,133 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "reclaimer.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///     RECLAIMER STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+struct ReclaimJobSt
+{
+    elem_t *elems;
+    size_t start;
+    size_t end;
+    delete_operator_t operator_delete;
+    struct ReclaimJobSt *next;
+};
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pending = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t idle = PTHREAD_COND_INITIALIZER;
+static pthread_t worker;
+
+static struct ReclaimJobSt *head = NULL;
+static struct ReclaimJobSt *tail = NULL;
+static char running = false;
+static char busy = false;
+static char stopping = false;
+
+///////////////////////////////////////////////////////////////////////////////
+///     RECLAIMER WORKER
+///////////////////////////////////////////////////////////////////////////////
+
+static void *reclaimer_loop(void *arg) {
+    struct ReclaimJobSt *job;
+
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (!head && !stopping) {
+            pthread_cond_wait(&pending, &lock);
+        }
+        if (!head) break;
+
+        job = head;
+        head = job->next;
+        if (!head) tail = NULL;
+        busy = true;
+        pthread_mutex_unlock(&lock);
+
+        if (job->operator_delete) {
+            for (size_t i = job->start; i < job->end; i++) {
+                job->operator_delete(job->elems[i]);
+            }
+        }
+        free(job->elems);
+        free(job);
+
+        pthread_mutex_lock(&lock);
+        busy = false;
+        if (!head) pthread_cond_broadcast(&idle);
+    }
+    pthread_mutex_unlock(&lock);
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     RECLAIMER FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+char reclaimer__defer(elem_t *elems, const size_t start, const size_t end, const delete_operator_t delete_op) {
+    if (!elems || start > end) return FAILURE;
+
+    struct ReclaimJobSt *job = malloc(sizeof(struct ReclaimJobSt));
+    if (!job) return FAILURE;
+
+    job->elems = elems;
+    job->start = start;
+    job->end = end;
+    job->operator_delete = delete_op;
+    job->next = NULL;
+
+    pthread_mutex_lock(&lock);
+    if (!running) {
+        stopping = false;
+        if (pthread_create(&worker, NULL, reclaimer_loop, NULL)) {
+            pthread_mutex_unlock(&lock);
+            free(job);
+            return FAILURE;
+        }
+        running = true;
+    }
+
+    if (tail) {
+        tail->next = job;
+    } else {
+        head = job;
+    }
+    tail = job;
+
+    pthread_cond_signal(&pending);
+    pthread_mutex_unlock(&lock);
+
+    return SUCCESS;
+}
+
+void reclaimer__flush(void) {
+    pthread_mutex_lock(&lock);
+    while (running && (head || busy)) {
+        pthread_cond_wait(&idle, &lock);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+void reclaimer__shutdown(void) {
+    pthread_mutex_lock(&lock);
+    if (!running) {
+        pthread_mutex_unlock(&lock);
+        return;
+    }
+    stopping = true;
+    pthread_cond_signal(&pending);
+    pthread_mutex_unlock(&lock);
+
+    pthread_join(worker, NULL);
+
+    pthread_mutex_lock(&lock);
+    running = false;
+    stopping = false;
+    pthread_mutex_unlock(&lock);
+}
@@ -0,0 +1,50 @@
+#ifndef __RECLAIMER_H__
+#define __RECLAIMER_H__
+
+#include <stddef.h>
+
+#include "defs.h"
+
+
+/**
+ * Background reclaimer destroying detached element buffers outside of the caller's thread
+ *
+ * Notes :
+ * 1) The reclaimer owns a single worker thread, lazily started on the first deferred buffer.
+ * Buffers are destroyed in submission order.
+ *
+ * 2) The delete operators handed to the reclaimer are called from the worker thread,
+ * they must therefore be thread-safe with respect to the rest of the program.
+ */
+
+
+/**
+ * @brief hands a detached buffer to the reclaimer
+ * @details on success the reclaimer owns 'elems': every element in [start, end) is deleted with 'delete_op'
+ * then the buffer itself is freed. On failure the caller keeps ownership of the buffer
+ * @note complexity: O(1)
+ * @param elems the detached buffer
+ * @param start position of the first element to delete
+ * @param end position following the last element to delete
+ * @param delete_op delete operator, NULL if the elements are not owned by the buffer
+ * @return 0 on success, -1 on failure
+ */
+char reclaimer__defer(elem_t *elems, const size_t start, const size_t end, const delete_operator_t delete_op);
+
+
+/**
+ * @brief blocks until every buffer handed to the reclaimer so far is destroyed
+ * @note complexity: O(n) where n is the number of pending elements
+ */
+void reclaimer__flush(void);
+
+
+/**
+ * @brief destroys all pending buffers then stops the worker thread
+ * @details the reclaimer is restarted by the next call to 'reclaimer__defer'
+ * @note complexity: O(n) where n is the number of pending elements
+ */
+void reclaimer__shutdown(void);
+
+
+#endif
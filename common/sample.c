@@ -0,0 +1,103 @@
+#include <stdlib.h>
+
+#include "sample.h"
+
+/**
+ * Empty slot of the position set, positions are always less than SIZE_MAX
+ */
+#define NO_POSITION SIZE_MAX
+
+///////////////////////////////////////////////////////////////////////////////
+///     SAMPLE UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+static inline uint64_t mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * Inserts the position in the open addressing set, returns false if it was already present
+ */
+static char set_insert(size_t *set, const size_t mask, const size_t position) {
+    size_t slot = (size_t)mix(position) & mask;
+
+    while (set[slot] != NO_POSITION) {
+        if (set[slot] == position) return false;
+        slot = (slot + 1) & mask;
+    }
+    set[slot] = position;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     SAMPLE FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+uint64_t sample__seed(const uint64_t seed) {
+    uint64_t state = mix(seed + 0x9e3779b97f4a7c15ULL);
+    return state ? state : 0x9e3779b97f4a7c15ULL;
+}
+
+uint64_t sample__next(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545f4914f6cdd1dULL;
+}
+
+size_t sample__below(uint64_t *state, const size_t n) {
+    uint64_t threshold = (0 - (uint64_t)n) % n;
+    uint64_t x;
+
+    do {
+        x = sample__next(state);
+    } while (x < threshold);
+
+    return (size_t)(x % n);
+}
+
+double sample__unit(uint64_t *state) {
+    return ((double)(sample__next(state) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+char sample__positions(const size_t n, const size_t k, uint64_t *state, size_t *positions) {
+    if (!positions || k > n) return FAILURE;
+    if (!k) return SUCCESS;
+
+    size_t capacity = 2;
+    while (capacity < 2 * k) capacity <<= 1;
+
+    size_t *set = malloc(sizeof(size_t) * capacity);
+    if (!set) return FAILURE;
+
+    for (size_t i = 0; i < capacity; i++) {
+        set[i] = NO_POSITION;
+    }
+
+    /* j is greater than every position drawn before, it is never in the set yet */
+    size_t t, m = 0;
+    for (size_t j = n - k; j < n; j++) {
+        t = sample__below(state, j + 1);
+        if (!set_insert(set, capacity - 1, t)) {
+            t = j;
+            set_insert(set, capacity - 1, j);
+        }
+        positions[m++] = t;
+    }
+
+    for (size_t i = k - 1; i > 0; i--) {
+        t = sample__below(state, i + 1);
+        m = positions[i];
+        positions[i] = positions[t];
+        positions[t] = m;
+    }
+
+    free(set);
+    return SUCCESS;
+}
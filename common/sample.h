@@ -0,0 +1,68 @@
+#ifndef __SAMPLE_H__
+#define __SAMPLE_H__
+
+#include <stddef.h>
+
+#include "defs.h"
+
+
+/**
+ * Pseudo-random generator and sampling algorithms shared by the ADTs
+ *
+ * The generator is a xorshift64* whose whole state is a 64-bit integer owned by the caller,
+ * it is fast and good enough for sampling but not cryptographically secure.
+ */
+
+
+/**
+ * @brief state of the generator seeded with the given value, the state is never 0
+ * @note complexity: O(1)
+ * @param seed the seed
+ * @return the state
+ */
+uint64_t sample__seed(const uint64_t seed);
+
+
+/**
+ * @brief next pseudo-random value of the generator
+ * @note complexity: O(1)
+ * @param state the state of the generator
+ * @return a uniform 64-bit value
+ */
+uint64_t sample__next(uint64_t *state);
+
+
+/**
+ * @brief uniform integer in [0, n) without modulo bias
+ * @note complexity: O(1) expected
+ * @param state the state of the generator
+ * @param n the upper bound, not 0
+ * @return the integer
+ */
+size_t sample__below(uint64_t *state, const size_t n);
+
+
+/**
+ * @brief uniform real in the open interval (0, 1)
+ * @note complexity: O(1)
+ * @param state the state of the generator
+ * @return the real
+ */
+double sample__unit(uint64_t *state);
+
+
+/**
+ * @brief draws k distinct positions among n, uniformly and in random order
+ * @details Floyd's algorithm draws a uniform k-subset with k random values and a hash set of the drawn positions,
+ * which are then shuffled
+ * @note complexity: O(k) expected, independent of n
+ * @param n number of positions
+ * @param k number of positions to draw, not greater than n
+ * @param state the state of the generator
+ * @param positions array of k positions filled by the function
+ * @return 0 on success, -1 on failure
+ */
+char sample__positions(const size_t n, const size_t k, uint64_t *state, size_t *positions);
+
+
+#endif
@@ -0,0 +1,357 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "sort.h"
+
+#define RADIX_BITS 8
+#define RADIX_SIZE (1<<RADIX_BITS)
+#define RADIX_PASSES (sizeof(uint64_t) * 8 / RADIX_BITS)
+
+#define TINY_SORT_THRESHOLD 32
+#define INSERTION_SORT_THRESHOLD 24
+#define NINTHER_THRESHOLD 128
+#define PARTIAL_INSERTION_LIMIT 8
+
+///////////////////////////////////////////////////////////////////////////////
+///     SORT STRUCTURES
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    uint64_t key;
+    elem_t elem;
+} KeyedElem;
+
+///////////////////////////////////////////////////////////////////////////////
+///     SORT UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+static inline void swap_elems(elem_t *a, elem_t *b) {
+    elem_t tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+static inline void reverse_elems(elem_t *elems, const size_t n) {
+    for (size_t i = 0, j = n - 1; i < j; i++, j--) {
+        swap_elems(elems + i, elems + j);
+    }
+}
+
+/**
+ * Orders the three elements in place
+ */
+static inline void sort3(elem_t *a, elem_t *b, elem_t *c, const compare_func_t cmp) {
+    if (cmp(b, a) < 0) swap_elems(a, b);
+    if (cmp(c, b) < 0) {
+        swap_elems(b, c);
+        if (cmp(b, a) < 0) swap_elems(a, b);
+    }
+}
+
+static void insertion_sort(elem_t *elems, const size_t n, const compare_func_t cmp) {
+    elem_t tmp;
+    size_t j;
+
+    for (size_t i = 1; i < n; i++) {
+        tmp = elems[i];
+        for (j = i; j > 0 && cmp(&tmp, elems + j - 1) < 0; j--) {
+            elems[j] = elems[j - 1];
+        }
+        elems[j] = tmp;
+    }
+}
+
+/**
+ * Insertion sort giving up once more than PARTIAL_INSERTION_LIMIT moves were made, returns true if the elements are sorted
+ */
+static char partial_insertion_sort(elem_t *elems, const size_t n, const compare_func_t cmp) {
+    size_t moves = 0;
+    elem_t tmp;
+    size_t j;
+
+    for (size_t i = 1; i < n; i++) {
+        tmp = elems[i];
+        for (j = i; j > 0 && cmp(&tmp, elems + j - 1) < 0; j--) {
+            elems[j] = elems[j - 1];
+        }
+        elems[j] = tmp;
+
+        moves += i - j;
+        if (moves > PARTIAL_INSERTION_LIMIT) return false;
+    }
+
+    return true;
+}
+
+static void sift_down(elem_t *elems, size_t root, const size_t n, const compare_func_t cmp) {
+    size_t child;
+
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n && cmp(elems + child, elems + child + 1) < 0) child++;
+        if (cmp(elems + root, elems + child) >= 0) return;
+        swap_elems(elems + root, elems + child);
+        root = child;
+    }
+}
+
+static void heap_sort(elem_t *elems, const size_t n, const compare_func_t cmp) {
+    for (size_t i = n / 2; i > 0; i--) {
+        sift_down(elems, i - 1, n, cmp);
+    }
+    for (size_t i = n - 1; i > 0; i--) {
+        swap_elems(elems, elems + i);
+        sift_down(elems, 0, i, cmp);
+    }
+}
+
+/**
+ * Partitions around the pivot elems[0], elements equal to the pivot go to the right.
+ * The pivot selection guarantees an element not less than the pivot after it, which bounds the scans
+ */
+static size_t partition_right(elem_t *elems, const size_t n, const compare_func_t cmp, char *already_partitioned) {
+    elem_t pivot = elems[0];
+    size_t first = 0;
+    size_t last = n;
+
+    while (cmp(elems + ++first, &pivot) < 0);
+
+    if (first == 1) {
+        while (first < last && cmp(elems + --last, &pivot) >= 0);
+    } else {
+        while (cmp(elems + --last, &pivot) >= 0);
+    }
+
+    *already_partitioned = first >= last;
+
+    while (first < last) {
+        swap_elems(elems + first, elems + last);
+        while (cmp(elems + ++first, &pivot) < 0);
+        while (cmp(elems + --last, &pivot) >= 0);
+    }
+
+    elems[0] = elems[first - 1];
+    elems[first - 1] = pivot;
+
+    return first - 1;
+}
+
+/**
+ * Partitions around the pivot elems[0], elements equal to the pivot go to the left.
+ * Used when the pivot equals the element preceding the range, the left part then only holds copies of the pivot
+ */
+static size_t partition_left(elem_t *elems, const size_t n, const compare_func_t cmp) {
+    elem_t pivot = elems[0];
+    size_t first = 0;
+    size_t last = n;
+
+    while (cmp(&pivot, elems + --last) < 0);
+
+    if (last + 1 == n) {
+        while (first < last && cmp(&pivot, elems + ++first) >= 0);
+    } else {
+        while (cmp(&pivot, elems + ++first) >= 0);
+    }
+
+    while (first < last) {
+        swap_elems(elems + first, elems + last);
+        while (cmp(&pivot, elems + --last) < 0);
+        while (cmp(&pivot, elems + ++first) >= 0);
+    }
+
+    elems[0] = elems[last];
+    elems[last] = pivot;
+
+    return last;
+}
+
+/**
+ * Swaps a few elements of a part left highly unbalanced by the last partition to break the input pattern
+ */
+static void break_patterns(elem_t *begin, elem_t *end) {
+    size_t n = (size_t)(end - begin);
+    if (n < INSERTION_SORT_THRESHOLD) return;
+
+    swap_elems(begin, begin + n / 4);
+    swap_elems(end - 1, end - n / 4);
+
+    if (n > NINTHER_THRESHOLD) {
+        swap_elems(begin + 1, begin + (n / 4 + 1));
+        swap_elems(begin + 2, begin + (n / 4 + 2));
+        swap_elems(end - 2, end - (n / 4 + 1));
+        swap_elems(end - 3, end - (n / 4 + 2));
+    }
+}
+
+/**
+ * Pattern-defeating quicksort, falls back to heap sort after too many unbalanced partitions
+ */
+static void pdq_sort(elem_t *elems, size_t n, const compare_func_t cmp, unsigned int bad_allowed, char leftmost) {
+    size_t half, pivot_pos, l_size, r_size;
+    char already_partitioned;
+
+    for (;;) {
+        if (n < INSERTION_SORT_THRESHOLD) {
+            insertion_sort(elems, n, cmp);
+            return;
+        }
+
+        half = n / 2;
+        if (n > NINTHER_THRESHOLD) {
+            sort3(elems, elems + half, elems + n - 1, cmp);
+            sort3(elems + 1, elems + half - 1, elems + n - 2, cmp);
+            sort3(elems + 2, elems + half + 1, elems + n - 3, cmp);
+            sort3(elems + half - 1, elems + half, elems + half + 1, cmp);
+            swap_elems(elems, elems + half);
+        } else {
+            sort3(elems + half, elems, elems + n - 1, cmp);
+        }
+
+        if (!leftmost && cmp(elems - 1, elems) >= 0) {
+            pivot_pos = partition_left(elems, n, cmp);
+            elems += pivot_pos + 1;
+            n -= pivot_pos + 1;
+            continue;
+        }
+
+        pivot_pos = partition_right(elems, n, cmp, &already_partitioned);
+        l_size = pivot_pos;
+        r_size = n - pivot_pos - 1;
+
+        if (l_size < n / 8 || r_size < n / 8) {
+            if (--bad_allowed == 0) {
+                heap_sort(elems, n, cmp);
+                return;
+            }
+            break_patterns(elems, elems + pivot_pos);
+            break_patterns(elems + pivot_pos + 1, elems + n);
+        } else if (already_partitioned
+                && partial_insertion_sort(elems, l_size, cmp)
+                && partial_insertion_sort(elems + pivot_pos + 1, r_size, cmp)) {
+            return;
+        }
+
+        pdq_sort(elems, l_size, cmp, bad_allowed, leftmost);
+        elems += pivot_pos + 1;
+        n = r_size;
+        leftmost = false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     SORT FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+void sort__hybrid(elem_t *elems, const size_t n, const compare_func_t cmp) {
+    if (!elems || !cmp || n < 2) return;
+
+    size_t run = 1;
+    while (run < n && cmp(elems + run - 1, elems + run) <= 0) run++;
+    if (run == n) return;
+
+    if (run == 1) {
+        while (run < n && cmp(elems + run - 1, elems + run) >= 0) run++;
+        if (run == n) {
+            reverse_elems(elems, n);
+            return;
+        }
+    }
+
+    if (n <= TINY_SORT_THRESHOLD) {
+        insertion_sort(elems, n, cmp);
+        return;
+    }
+
+    unsigned int bad_allowed = 0;
+    for (size_t m = n; m > 1; m >>= 1) bad_allowed++;
+
+    pdq_sort(elems, n, cmp, bad_allowed, true);
+}
+
+char sort__by_key(elem_t *elems, const size_t n, const key_func_t key) {
+    if (!elems || !key) return FAILURE;
+    if (n < 2) return SUCCESS;
+
+    KeyedElem *pairs = malloc(sizeof(KeyedElem) * n);
+    KeyedElem *tmp = malloc(sizeof(KeyedElem) * n);
+    size_t (*counts)[RADIX_SIZE] = calloc(RADIX_PASSES, sizeof(*counts));
+    if (!pairs || !tmp || !counts) {
+        free(pairs);
+        free(tmp);
+        free(counts);
+        return FAILURE;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        pairs[i].key = key(elems[i]);
+        pairs[i].elem = elems[i];
+        for (size_t p = 0; p < RADIX_PASSES; p++) {
+            counts[p][(pairs[i].key >> (p * RADIX_BITS)) & (RADIX_SIZE - 1)]++;
+        }
+    }
+
+    KeyedElem *src = pairs;
+    KeyedElem *dst = tmp;
+    KeyedElem *swap;
+    size_t offset, count;
+    unsigned int digit;
+
+    for (size_t p = 0; p < RADIX_PASSES; p++) {
+        digit = (unsigned int)((src[0].key >> (p * RADIX_BITS)) & (RADIX_SIZE - 1));
+        if (counts[p][digit] == n) continue;
+
+        offset = 0;
+        for (size_t d = 0; d < RADIX_SIZE; d++) {
+            count = counts[p][d];
+            counts[p][d] = offset;
+            offset += count;
+        }
+        for (size_t i = 0; i < n; i++) {
+            digit = (unsigned int)((src[i].key >> (p * RADIX_BITS)) & (RADIX_SIZE - 1));
+            dst[counts[p][digit]++] = src[i];
+        }
+
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        elems[i] = src[i].elem;
+    }
+
+    free(pairs);
+    free(tmp);
+    free(counts);
+    return SUCCESS;
+}
+
+char sort__by_cached_key(elem_t *elems, const size_t n, const size_t key_size, const key_extract_func_t extract, const compare_func_t cmp) {
+    if (!elems || !key_size || !extract || !cmp) return FAILURE;
+    if (n < 2) return SUCCESS;
+
+    /* each record holds the key followed by its element, aligned on the element */
+    size_t elem_offset = (key_size + sizeof(elem_t) - 1) / sizeof(elem_t) * sizeof(elem_t);
+    size_t record_size = elem_offset + sizeof(elem_t);
+
+    char *records = malloc(record_size * n);
+    if (!records) return FAILURE;
+
+    char *record = records;
+    for (size_t i = 0; i < n; i++) {
+        extract(elems[i], record);
+        memcpy(record + elem_offset, elems + i, sizeof(elem_t));
+        record += record_size;
+    }
+
+    qsort(records, n, record_size, cmp);
+
+    record = records;
+    for (size_t i = 0; i < n; i++) {
+        memcpy(elems + i, record + elem_offset, sizeof(elem_t));
+        record += record_size;
+    }
+
+    free(records);
+    return SUCCESS;
+}
@@ -0,0 +1,54 @@
+#ifndef __SORT_H__
+#define __SORT_H__
+
+#include <stddef.h>
+
+#include "defs.h"
+
+
+/**
+ * Sorting algorithms on arrays of elements shared by the ADTs
+ */
+
+
+/**
+ * @brief sorts the elements with an algorithm chosen by size and presortedness
+ * @details a linear check first returns on already sorted input and reverses descending input,
+ * tiny inputs are insertion sorted and larger ones use a pattern-defeating quicksort with a heap sort fallback.
+ * 'cmp' receives pointers to elements as with qsort. The sort is not stable
+ * @note complexity: O(n*log(n)), O(n) on sorted or reverse sorted input
+ * @param elems the elements
+ * @param n number of elements
+ * @param cmp the compare function
+ */
+void sort__hybrid(elem_t *elems, const size_t n, const compare_func_t cmp);
+
+
+/**
+ * @brief sorts the elements by an integer key computed once per element
+ * @details the (key, element) pairs are sorted with a stable LSD radix sort, byte positions shared by all keys are skipped
+ * @note complexity: O(n) with exactly n calls to 'key'
+ * @param elems the elements
+ * @param n number of elements
+ * @param key the key function, receives an element
+ * @return 0 on success, -1 on failure
+ */
+char sort__by_key(elem_t *elems, const size_t n, const key_func_t key);
+
+
+/**
+ * @brief sorts the elements by a key extracted once per element
+ * @details the keys are stored next to their element in a side array which is sorted with 'cmp',
+ * 'cmp' receives pointers to keys
+ * @note complexity: O(n*log(n)) with exactly n calls to 'extract'
+ * @param elems the elements
+ * @param n number of elements
+ * @param key_size byte size of a key
+ * @param extract the extraction function, receives an element and the buffer where to write its key
+ * @param cmp the compare function
+ * @return 0 on success, -1 on failure
+ */
+char sort__by_cached_key(elem_t *elems, const size_t n, const size_t key_size, const key_extract_func_t extract, const compare_func_t cmp);
+
+
+#endif
@@ -1,19 +1,208 @@
 #ifndef __VEC_H__
 #define __VEC_H__
 
+/**
+ * Number of elements ahead of the current one whose pointee is prefetched by the scans
+ * dereferencing elements (SEARCH, FOREACH, FILTER, ALL, ANY), 0 disables prefetching.
+ * PREFETCH_ORIENTED looks ahead in the logical order of the scans going through ORIENT
+ */
+#ifndef PREFETCH_DISTANCE
+#define PREFETCH_DISTANCE 16
+#endif
+
+#if PREFETCH_DISTANCE > 0
+#define PREFETCH_ELEM(__elems, __i, __end) \
+    ((__i) + PREFETCH_DISTANCE < (__end) ? __builtin_prefetch((__elems)[(__i) + PREFETCH_DISTANCE]) : (void)0)
+#define PREFETCH_ORIENTED(__ptr, __start, __end, __i) \
+    ((__i) + PREFETCH_DISTANCE < (__end) \
+     ? __builtin_prefetch((__ptr)->elems[ORIENT(__ptr, __start, __end, (__i) + PREFETCH_DISTANCE)]) : (void)0)
+#else
+#define PREFETCH_ELEM(__elems, __i, __end) \
+    ((void)0)
+#define PREFETCH_ORIENTED(__ptr, __start, __end, __i) \
+    ((void)0)
+#endif
+
 #define PTR_INCREMENT(__ptr, __size) \
     (__ptr) = (void *)((size_t)(__ptr) + (__size))
 
+/**
+ * Number of elements migrated from the old buffer by every operation of a structure in incremental resize mode
+ */
+#ifndef MIGRATE_STEP
+#define MIGRATE_STEP 4
+#endif
+
+/**
+ * Slot of the element at position i, which is still in the old buffer if a migration is pending and
+ * the element has not been migrated yet
+ */
+#define SLOT(__ptr, __i) \
+    (*((__ptr)->old_elems && (__i) >= (__ptr)->migrated && (__i) < (__ptr)->old_end \
+       ? (__ptr)->old_elems + ((__ptr)->old_shift + (__i)) : (__ptr)->elems + (__i)))
+
+/**
+ * Migrates at most n elements of the old buffer, which is freed once all live elements are migrated.
+ * Elements before the front are dead and skipped
+ */
+#define MIGRATE(__ptr, __front, __n) do { \
+    if ((__ptr)->old_elems) { \
+        size_t __end_mig = (__ptr)->old_end < (__ptr)->back ? (__ptr)->old_end : (__ptr)->back; \
+        size_t __n_mig = (__n); \
+        size_t __front_mig = (__front); \
+        if ((__ptr)->migrated < __front_mig) (__ptr)->migrated = __front_mig; \
+        for (; __n_mig && (__ptr)->migrated < __end_mig; __n_mig--, (__ptr)->migrated++) { \
+            (__ptr)->elems[(__ptr)->migrated] = (__ptr)->old_elems[(__ptr)->old_shift + (__ptr)->migrated]; \
+        } \
+        if ((__ptr)->migrated >= __end_mig) { \
+            free((__ptr)->old_elems); \
+            (__ptr)->old_elems = NULL; \
+        } \
+    } \
+} while (false)
+
+#define MIGRATE_ALL(__ptr, __front) \
+    MIGRATE(__ptr, __front, SIZE_MAX)
+
+/**
+ * Starts the migration of the elements in [front, back) to a new buffer, where they are moved to
+ * [new_front, new_front + back - front). The caller sets its front to new_front. A pending migration is completed first.
+ * The shift between both buffers may wrap around, SLOT and MIGRATE add it to the position before indexing
+ */
+#define REBASE_AT(__ptr, __front, __new_front, __new_capacity) \
+({ \
+    int __result_reb = FAILURE; \
+    MIGRATE_ALL(__ptr, __front); \
+    elem_t *__new_elems = alloc__elems(__new_capacity); \
+    if (__new_elems) { \
+        (__ptr)->old_elems = (__ptr)->elems; \
+        (__ptr)->old_shift = (__front) - (__new_front); \
+        (__ptr)->old_end = (__ptr)->back - (__front) + (__new_front); \
+        (__ptr)->migrated = (__new_front); \
+        (__ptr)->elems = __new_elems; \
+        (__ptr)->capacity = (__new_capacity); \
+        (__ptr)->back = (__ptr)->old_end; \
+        __result_reb = SUCCESS; \
+    } \
+    (char)__result_reb; \
+})
+
+/**
+ * Starts the migration of the elements in [front, back) to [0, back - front) of a new buffer, the caller resets its front
+ */
+#define REBASE(__ptr, __front, __new_capacity) \
+    REBASE_AT(__ptr, __front, 0, __new_capacity)
+
+/**
+ * Incremental counterpart of ENSURE_CAPACITY for a full buffer, rebased to a buffer of the same capacity
+ * if at most half of it is live, and of twice its capacity otherwise, but never smaller than min_capacity.
+ * Fails if the new buffer would have no free slot after the live elements
+ */
+#define INCREMENTAL_GROW(__ptr, __front, __min_capacity) \
+({ \
+    size_t __n_inc = (__ptr)->back - (__front); \
+    size_t __capacity_inc = (__ptr)->capacity; \
+    if (__n_inc >= __capacity_inc>>1) { \
+        __capacity_inc = (__capacity_inc < SIZE_MAX>>1) ? __capacity_inc<<1 : SIZE_MAX; \
+    } \
+    if (__capacity_inc < (__min_capacity)) __capacity_inc = (__min_capacity); \
+    __capacity_inc > __n_inc ? REBASE(__ptr, __front, __capacity_inc) : (char)FAILURE; \
+})
+
+/**
+ * Moves the elements of [front, back) to the middle of the buffer to make room before the front, for the structures
+ * adding elements at both ends. The buffer first grows by half if at most a quarter of the length is free, so that
+ * the room made is proportional to the length. Evaluates to the new front, SIZE_MAX on failure
+ */
+#define RECENTER(__ptr, __front) \
+({ \
+    size_t __n_rec = (__ptr)->back - (__front); \
+    size_t __front_rec = SIZE_MAX; \
+    if ((__ptr)->capacity - __n_rec > __n_rec>>2 || !RESIZE(__ptr, (__ptr)->capacity + ((__ptr)->capacity>>1) + 1)) { \
+        __front_rec = ((__ptr)->capacity - __n_rec + 1)>>1; \
+        memmove((__ptr)->elems + __front_rec, (__ptr)->elems + (__front), sizeof(elem_t) * __n_rec); \
+        (__ptr)->back = __front_rec + __n_rec; \
+    } \
+    __front_rec; \
+})
+
+/**
+ * Incremental counterpart of RECENTER, the elements are rebased to the middle of a buffer sized as with
+ * INCREMENTAL_GROW. Evaluates to the new front, SIZE_MAX on failure
+ */
+#define INCREMENTAL_RECENTER(__ptr, __front, __min_capacity) \
+({ \
+    size_t __n_irc = (__ptr)->back - (__front); \
+    size_t __capacity_irc = (__ptr)->capacity; \
+    if (__n_irc >= __capacity_irc>>1) { \
+        __capacity_irc = (__capacity_irc < SIZE_MAX>>1) ? __capacity_irc<<1 : SIZE_MAX; \
+    } \
+    if (__capacity_irc < (__min_capacity)) __capacity_irc = (__min_capacity); \
+    size_t __front_irc = (__capacity_irc - __n_irc + 1)>>1; \
+    __capacity_irc > __n_irc && REBASE_AT(__ptr, __front, __front_irc, __capacity_irc) == SUCCESS \
+        ? __front_irc : SIZE_MAX; \
+})
+
 #define SWAP(__ptr, __i, __j) \
-    elem_t *__elems = (__ptr)->elems; \
-    elem_t __temp = __elems[__i]; \
-    __elems[__i] = __elems[__j]; \
-    __elems[__j] = __temp
+    elem_t __temp = SLOT(__ptr, __i); \
+    SLOT(__ptr, __i) = SLOT(__ptr, __j); \
+    SLOT(__ptr, __j) = __temp
+
+/**
+ * Physical position of the element at logical position i in [start, end), mirrored when the structure is
+ * logically reversed. The mapping is its own inverse
+ */
+#define ORIENT(__ptr, __start, __end, __i) \
+    ((__ptr)->reversed ? (__start) + (__end) - 1 - (__i) : (__i))
+
+/**
+ * Physically reverses [start, end) if the structure is logically reversed, so that the physical order matches the logical one
+ */
+#define MATERIALIZE(__ptr, __start, __end) do { \
+    if ((__ptr)->reversed) { \
+        (__ptr)->reversed = false; \
+        for (size_t __i_mat = (__start), __j_mat = (__end); __i_mat + 1 < __j_mat; __i_mat++, __j_mat--) { \
+            SWAP(__ptr, __i_mat, __j_mat - 1); \
+        } \
+    } \
+} while (false)
+
+/**
+ * Position of the first element of [start, end) not less than the element stored in the variable 'elem',
+ * for elements sorted with cmp
+ */
+#define LOWER_BOUND(__ptr, __start, __end, __elem, __cmp) \
+({ \
+    size_t __lo = (__start); \
+    size_t __hi = (__end); \
+    size_t __mid; \
+    while (__lo < __hi) { \
+        __mid = __lo + ((__hi - __lo)>>1); \
+        if ((__cmp)(&SLOT(__ptr, __mid), &(__elem)) < 0) { \
+            __lo = __mid + 1; \
+        } else { \
+            __hi = __mid; \
+        } \
+    } \
+    __lo; \
+})
+
+/**
+ * Checks if the elements of [start, end) are sorted with cmp
+ */
+#define IS_SORTED_RANGE(__ptr, __start, __end, __cmp) \
+({ \
+    size_t __pos_srt = (__start) + 1; \
+    while (__pos_srt < (__end) && (__cmp)((__ptr)->elems + __pos_srt - 1, (__ptr)->elems + __pos_srt) <= 0) { \
+        __pos_srt++; \
+    } \
+    (char)(__pos_srt >= (__end)); \
+})
 
 #define RESIZE(__ptr, __new_capacity) \
 ({ \
     int __result_res = FAILURE; \
-    elem_t *__realloc_res = realloc((__ptr)->elems, sizeof(elem_t) * (__new_capacity)); \
+    elem_t *__realloc_res = alloc__resize_elems((__ptr)->elems, (__ptr)->capacity, (__new_capacity)); \
     if (__realloc_res) { \
         (__ptr)->elems = __realloc_res; \
         (__ptr)->capacity = (__new_capacity); \
@@ -59,11 +248,14 @@
     (__dst)->length = (__src)->length; \
 })
 
+/**
+ * The scans below visit [start, end) in logical order through ORIENT, positions are logical ones
+ */
 #define PTR_SEARCH(__ptr, __start, __end, __elem) \
 ({ \
     elem_t *__elems = (__ptr)->elems; \
     size_t __pos = (__start); \
-    while (__pos < (__end) && __elems[__pos] != (__elem)) { \
+    while (__pos < (__end) && __elems[ORIENT(__ptr, __start, __end, __pos)] != (__elem)) { \
         __pos++; \
     } \
     __pos == (__end) ? SIZE_MAX : __pos; \
@@ -73,17 +265,22 @@
 ({ \
     elem_t *__elems = (__ptr)->elems; \
     size_t __pos = (__start); \
-    while (__pos < (__end) && !(__match)(__elems[__pos], (__elem))) { \
+    while (__pos < (__end) && (PREFETCH_ORIENTED(__ptr, __start, __end, __pos), \
+                               !(__match)(__elems[ORIENT(__ptr, __start, __end, __pos)], (__elem)))) { \
         __pos++; \
     } \
     __pos == (__end) ? SIZE_MAX : __pos; \
 })
 
-#define ARRAY_CMP(__ptr_1, __ptr_2, __match, __n_elems) \
+/**
+ * Matches the elements of [start_1, end_1) and of [start_2, end_2), ranges of the same length, in logical order
+ */
+#define RANGE_CMP(__ptr_1, __start_1, __end_1, __ptr_2, __start_2, __end_2, __match) \
 ({ \
     int __result_cmp = true; \
-    for (size_t i = 0; i < (__n_elems) && __result_cmp; i++) { \
-        __result_cmp &= (__match)((__ptr_1)[i], (__ptr_2)[i]); \
+    for (size_t i = 0; i < (__end_1) - (__start_1) && __result_cmp; i++) { \
+        __result_cmp &= (__match)((__ptr_1)->elems[ORIENT(__ptr_1, __start_1, __end_1, (__start_1) + i)], \
+                                  (__ptr_2)->elems[ORIENT(__ptr_2, __start_2, __end_2, (__start_2) + i)]); \
     } \
     (char)__result_cmp; \
 })
@@ -93,18 +290,20 @@
     char __repeated; \
     if ((__ptr)->copy_enabled) { \
         for (size_t i = (__start); i < (__end); i++) { \
-            (__func)(__elems[i], (__user_data)); \
+            PREFETCH_ORIENTED(__ptr, __start, __end, i); \
+            (__func)(__elems[ORIENT(__ptr, __start, __end, i)], (__user_data)); \
         } \
     } else { \
         __repeated = false; \
         for (size_t i = (__start); i < (__end); i++) { \
             for (size_t j = (__start); j < i && !__repeated; j++) { \
-                if (__elems[i] == __elems[j]) { \
+                if (__elems[ORIENT(__ptr, __start, __end, i)] == __elems[ORIENT(__ptr, __start, __end, j)]) { \
                     __repeated = true; \
                 } \
             } \
             if (!__repeated) { \
-                (__func)(__elems[i], (__user_data)); \
+                PREFETCH_ORIENTED(__ptr, __start, __end, i); \
+                (__func)(__elems[ORIENT(__ptr, __start, __end, i)], (__user_data)); \
             } \
             __repeated = false; \
         } \
@@ -115,8 +314,9 @@
     elem_t *__elems = (__ptr)->elems; \
     size_t k = 0; \
     for (size_t i = (__start); i < (__end); i++) { \
+        PREFETCH_ELEM(__elems, i, __end); \
         if ((__pred)(__elems[i], (__user_data))) { \
-            __elems[k] = __elems[i]; \
+            __elems[(__start) + k] = __elems[i]; \
             k++; \
         } else { \
             (__ptr)->operator_delete(__elems[i]); \
@@ -129,7 +329,8 @@
     elem_t *__elems = (__ptr)->elems; \
     int __result_all = true; \
     for (size_t i = (__start); i < (__end); i++) { \
-        __result_all &= (__pred)(__elems[i], (__user_data)); \
+        PREFETCH_ORIENTED(__ptr, __start, __end, i); \
+        __result_all &= (__pred)(__elems[ORIENT(__ptr, __start, __end, i)], (__user_data)); \
     } \
     (char)__result_all; \
 })
@@ -139,7 +340,8 @@
     elem_t *__elems = (__ptr)->elems; \
     int __result_any = false; \
     for (size_t i = (__start); i < (__end) && !__result_any; i++) { \
-        __result_any |= (__pred)(__elems[i], (__user_data)); \
+        PREFETCH_ORIENTED(__ptr, __start, __end, i); \
+        __result_any |= (__pred)(__elems[ORIENT(__ptr, __start, __end, i)], (__user_data)); \
     } \
     (char)__result_any; \
 })
@@ -148,8 +350,8 @@
     size_t __i, __j; \
     srand(__seed); \
     for (size_t i = (__start); i < (__end); i++) { \
-        __i = ((__start) + (size_t)(rand() % (int)((__start) + (__end)))); \
-        __j = ((__start) + (size_t)(rand() % (int)((__start) + (__end)))); \
+        __i = ((__start) + (size_t)(rand() % (int)((__end) - (__start)))); \
+        __j = ((__start) + (size_t)(rand() % (int)((__end) - (__start)))); \
         SWAP(__ptr, __i, __j); \
     } \
 } while (false)
@@ -159,7 +361,7 @@
     size_t k = 0; \
     for (size_t i = (__start); i < (__end); i++) { \
         if (__elems[i]) { \
-            __elems[k] = __elems[i]; \
+            __elems[(__start) + k] = __elems[i]; \
             k++; \
         } \
     } \
@@ -176,4 +378,53 @@
     (__ptr)->length = 0; \
 } while (false)
 
+#define COMPACT_ELEMS(__ptr, __start, __end) \
+({ \
+    int __result_cpt = FAILURE; \
+    elem_t *__elems = (__ptr)->elems; \
+    size_t __n_cpt = (__end) - (__start); \
+    size_t __k = 0; \
+    elem_t *__copies = malloc(sizeof(elem_t) * (__n_cpt ? __n_cpt : 1)); \
+    if (__copies) { \
+        for (; __k < __n_cpt; __k++) { \
+            __copies[__k] = (__ptr)->operator_copy(__elems[(__start) + __k]); \
+            if (!__copies[__k] && __elems[(__start) + __k]) break; \
+        } \
+        if (__k == __n_cpt) { \
+            for (size_t i = 0; i < __n_cpt; i++) { \
+                (__ptr)->operator_delete(__elems[(__start) + i]); \
+                __elems[(__start) + i] = __copies[i]; \
+            } \
+            __result_cpt = SUCCESS; \
+        } else { \
+            for (size_t i = 0; i < __k; i++) { \
+                (__ptr)->operator_delete(__copies[i]); \
+            } \
+        } \
+        free(__copies); \
+    } \
+    (char)__result_cpt; \
+})
+
+/**
+ * Immediate values are stored shifted left with their low bit set, so that none of them is NULL, which marks
+ * the removed elements. The tagging preserves the order of the values
+ */
+#define IMMEDIATE_FITS(__value) ((__value) <= (UINTPTR_MAX>>1))
+
+#define IMMEDIATE_TO_ELEM(__value) \
+    ((elem_t)(((uintptr_t)(__value) << 1) | 1))
+
+#define ELEM_TO_IMMEDIATE(__elem) \
+    ((uint64_t)((uintptr_t)(__elem) >> 1))
+
+static inline int immediate_compare(const void *a, const void *b) {
+    uintptr_t __a = *(const uintptr_t *)a;
+    uintptr_t __b = *(const uintptr_t *)b;
+    return (__a > __b) - (__a < __b);
+}
+
+#define IMMEDIATE_SORT(__ptr, __start, __end) \
+    sort__hybrid((__ptr)->elems + (__start), (__end) - (__start), immediate_compare)
+
 #endif
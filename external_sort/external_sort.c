@@ -0,0 +1,334 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "external_sort.h"
+#include "../common/sort.h"
+
+#ifndef EXTERNAL_SORT_MAX_WAYS
+#define EXTERNAL_SORT_MAX_WAYS 64
+#endif
+
+#define DEFAULT_RUNS_CAPACITY 8
+
+///////////////////////////////////////////////////////////////////////////////
+///     EXTERNAL SORT STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+struct ExternalSortSt
+{
+    elem_t *buffer;
+    size_t buffered;
+    size_t position;
+    size_t run_length;
+    size_t length;
+    FILE **runs;
+    size_t n_runs;
+    size_t runs_capacity;
+    compare_func_t cmp;
+    serialize_func_t serialize;
+    deserialize_func_t deserialize;
+    delete_operator_t operator_delete;
+};
+
+/**
+ * A run being merged, the in-memory run has no file and reads the buffer from its position
+ */
+typedef struct
+{
+    elem_t head;
+    FILE *file;
+} MergeSource;
+
+/**
+ * Consumes a merged element, the element is owned by the function
+ */
+typedef char (*emit_func_t)(const ExternalSort, elem_t, void *);
+
+typedef struct
+{
+    applying_func_t func;
+    void *user_data;
+} FuncSink;
+
+///////////////////////////////////////////////////////////////////////////////
+///     EXTERNAL SORT UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+static char runs_reserve(const ExternalSort es) {
+    if (es->n_runs < es->runs_capacity) return SUCCESS;
+
+    size_t capacity = es->runs_capacity ? es->runs_capacity<<1 : DEFAULT_RUNS_CAPACITY;
+    FILE **runs = realloc(es->runs, sizeof(FILE *) * capacity);
+    if (!runs) return FAILURE;
+
+    es->runs = runs;
+    es->runs_capacity = capacity;
+
+    return SUCCESS;
+}
+
+/**
+ * Sorts the buffer and writes it to a new run, the buffer is emptied on success
+ */
+static char spill_buffer(const ExternalSort es) {
+    if (runs_reserve(es) < 0) return FAILURE;
+
+    FILE *file = tmpfile();
+    if (!file) return FAILURE;
+
+    sort__hybrid(es->buffer, es->buffered, es->cmp);
+
+    for (size_t i = 0; i < es->buffered; i++) {
+        if (es->serialize(es->buffer[i], file) < 0) {
+            fclose(file);
+            return FAILURE;
+        }
+    }
+    if (fflush(file) || fseek(file, 0, SEEK_SET)) {
+        fclose(file);
+        return FAILURE;
+    }
+
+    for (size_t i = 0; i < es->buffered; i++) {
+        es->operator_delete(es->buffer[i]);
+    }
+    es->buffered = 0;
+    es->runs[es->n_runs++] = file;
+
+    return SUCCESS;
+}
+
+/**
+ * Reads the next element of the source, returns -1 on a read error
+ */
+static char source_next(const ExternalSort es, MergeSource *source) {
+    if (!source->file) {
+        source->head = es->position < es->buffered ? es->buffer[es->position++] : NULL;
+        return SUCCESS;
+    }
+
+    source->head = es->deserialize(source->file);
+
+    return (!source->head && ferror(source->file)) ? FAILURE : SUCCESS;
+}
+
+static void heap_sift_down(const ExternalSort es, MergeSource *heap, size_t root, const size_t n) {
+    MergeSource tmp;
+    size_t child;
+
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n && es->cmp(&heap[child + 1].head, &heap[child].head) < 0) child++;
+        if (es->cmp(&heap[root].head, &heap[child].head) <= 0) return;
+        tmp = heap[root];
+        heap[root] = heap[child];
+        heap[child] = tmp;
+        root = child;
+    }
+}
+
+/**
+ * K-way merge of the sources into 'emit', the heads left by a failure are deleted
+ */
+static char merge_sources(const ExternalSort es, MergeSource *sources, size_t k, const emit_func_t emit, void *ctx) {
+    size_t n = 0;
+    char res = SUCCESS;
+
+    for (size_t i = 0; i < k; i++) {
+        if (source_next(es, sources + i) < 0) res = FAILURE;
+        if (sources[i].head) sources[n++] = sources[i];
+    }
+    for (size_t i = n / 2; i > 0; i--) {
+        heap_sift_down(es, sources, i - 1, n);
+    }
+
+    while (n && res == SUCCESS) {
+        if (emit(es, sources[0].head, ctx) < 0 || source_next(es, sources) < 0) {
+            sources[0].head = NULL;
+            res = FAILURE;
+        }
+        if (!sources[0].head) sources[0] = sources[--n];
+        heap_sift_down(es, sources, 0, n);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        es->operator_delete(sources[i].head);
+    }
+
+    return res;
+}
+
+static char emit_to_file(const ExternalSort es, elem_t elem, void *ctx) {
+    char res = es->serialize(elem, ctx);
+    es->operator_delete(elem);
+    return res;
+}
+
+static char emit_to_queue(const ExternalSort es, elem_t elem, void *ctx) {
+    char res = queue__enqueue(ctx, elem);
+    if (res < 0 || queue__is_copy_enabled(ctx)) es->operator_delete(elem);
+    return res;
+}
+
+static char emit_to_func(const ExternalSort es, elem_t elem, void *ctx) {
+    FuncSink *sink = ctx;
+    sink->func(elem, sink->user_data);
+    es->operator_delete(elem);
+    return SUCCESS;
+}
+
+/**
+ * Merges the first EXTERNAL_SORT_MAX_WAYS runs into a single new run
+ */
+static char merge_runs_pass(const ExternalSort es, MergeSource *sources) {
+    char res = SUCCESS;
+    size_t k = EXTERNAL_SORT_MAX_WAYS;
+
+    FILE *file = tmpfile();
+    if (!file) return FAILURE;
+
+    for (size_t i = 0; i < k; i++) {
+        sources[i].file = es->runs[i];
+    }
+
+    res = merge_sources(es, sources, k, emit_to_file, file);
+    if (res == SUCCESS && (fflush(file) || fseek(file, 0, SEEK_SET))) res = FAILURE;
+
+    for (size_t i = 0; i < k; i++) {
+        fclose(es->runs[i]);
+    }
+    for (size_t i = k; i < es->n_runs; i++) {
+        es->runs[i - k] = es->runs[i];
+    }
+    es->n_runs -= k;
+    es->runs[es->n_runs++] = file;
+
+    return res;
+}
+
+/**
+ * Deletes the buffered elements not yet merged and removes the runs
+ */
+static void reset(const ExternalSort es) {
+    for (size_t i = es->position; i < es->buffered; i++) {
+        es->operator_delete(es->buffer[i]);
+    }
+    for (size_t i = 0; i < es->n_runs; i++) {
+        fclose(es->runs[i]);
+    }
+    es->buffered = 0;
+    es->position = 0;
+    es->n_runs = 0;
+    es->length = 0;
+}
+
+static char merge_all(const ExternalSort es, const emit_func_t emit, void *ctx) {
+    size_t k = es->n_runs < EXTERNAL_SORT_MAX_WAYS ? es->n_runs + 1 : EXTERNAL_SORT_MAX_WAYS + 1;
+    MergeSource *sources = malloc(sizeof(MergeSource) * k);
+    char res = sources ? SUCCESS : FAILURE;
+
+    while (res == SUCCESS && es->n_runs > EXTERNAL_SORT_MAX_WAYS) {
+        res = merge_runs_pass(es, sources);
+    }
+
+    if (res == SUCCESS) {
+        sort__hybrid(es->buffer, es->buffered, es->cmp);
+
+        for (size_t i = 0; i < es->n_runs; i++) {
+            sources[i].file = es->runs[i];
+        }
+        sources[es->n_runs].file = NULL;
+
+        res = merge_sources(es, sources, es->n_runs + 1, emit, ctx);
+    }
+
+    reset(es);
+    free(sources);
+    return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     EXTERNAL SORT FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+ExternalSort external_sort__empty(const size_t run_length, const compare_func_t cmp, const serialize_func_t serialize,
+                                  const deserialize_func_t deserialize, const delete_operator_t delete_op) {
+    if (!run_length || !cmp || !serialize || !deserialize || !delete_op) return NULL;
+
+    ExternalSort es = malloc(sizeof(struct ExternalSortSt));
+    if (!es) return NULL;
+
+    es->buffer = malloc(sizeof(elem_t) * run_length);
+    if (!es->buffer) {
+        free(es);
+        return NULL;
+    }
+
+    es->buffered = 0;
+    es->position = 0;
+    es->run_length = run_length;
+    es->length = 0;
+    es->runs = NULL;
+    es->n_runs = 0;
+    es->runs_capacity = 0;
+    es->cmp = cmp;
+    es->serialize = serialize;
+    es->deserialize = deserialize;
+    es->operator_delete = delete_op;
+
+    return es;
+}
+
+inline size_t external_sort__length(const ExternalSort es) {
+    return es ? es->length : SIZE_MAX;
+}
+
+inline size_t external_sort__n_runs(const ExternalSort es) {
+    return es ? es->n_runs : SIZE_MAX;
+}
+
+char external_sort__push(const ExternalSort es, const elem_t element) {
+    if (!es || !element) return FAILURE;
+
+    if (es->buffered == es->run_length && spill_buffer(es) < 0) return FAILURE;
+
+    es->buffer[es->buffered++] = element;
+    es->length++;
+
+    return SUCCESS;
+}
+
+char external_sort__push_queue(const ExternalSort es, const Queue q) {
+    if (!es || !q) return FAILURE;
+
+    elem_t elem;
+    while (!queue__is_empty(q)) {
+        if (es->buffered == es->run_length && spill_buffer(es) < 0) return FAILURE;
+        queue__dequeue(q, &elem);
+        if (external_sort__push(es, elem) < 0) return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+char external_sort__merge(const ExternalSort es, const applying_func_t func, void *user_data) {
+    if (!es || !func) return FAILURE;
+
+    FuncSink sink = {func, user_data};
+
+    return merge_all(es, emit_to_func, &sink);
+}
+
+char external_sort__merge_into(const ExternalSort es, const Queue q) {
+    if (!es || !q) return FAILURE;
+
+    return merge_all(es, emit_to_queue, q);
+}
+
+void external_sort__free(const ExternalSort es) {
+    if (!es) return;
+
+    reset(es);
+    free(es->runs);
+    free(es->buffer);
+    free(es);
+}
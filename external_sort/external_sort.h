@@ -0,0 +1,116 @@
+#ifndef __EXTERNAL_SORT_H__
+#define __EXTERNAL_SORT_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+#include "../queue/queue.h"
+
+
+/**
+ * Implementation of an external merge sort, sorting more elements than fit in memory
+ *
+ * Notes :
+ * 1) Pushed elements are buffered until 'run_length' of them are held, they are then sorted in memory,
+ * written to a temporary file with the serialize function and deleted. 'run_length' is therefore
+ * the memory budget of the sorter, counted in elements.
+ *
+ * 2) Merging reads the runs back with the deserialize function and outputs the elements in order
+ * with a k-way merge. At most EXTERNAL_SORT_MAX_WAYS runs are merged at once, more runs are first
+ * merged into longer ones.
+ *
+ * 3) The sorter owns the pushed elements and deletes them with its delete operator. NULL elements
+ * can not be sorted since the deserialize function returns NULL at the end of a run.
+ */
+typedef struct ExternalSortSt * ExternalSort;
+
+
+/**
+ * @brief create an empty external sorter
+ * @note complexity: O(1)
+ * @param run_length maximum number of elements held in memory
+ * @param cmp the compare function, receives pointers to elements as with qsort
+ * @param serialize the serialization function
+ * @param deserialize the deserialization function
+ * @param delete_op the delete operator
+ * @return a pointer to the sorter on success, NULL on failure
+ */
+ExternalSort external_sort__empty(const size_t run_length, const compare_func_t cmp, const serialize_func_t serialize,
+                                  const deserialize_func_t deserialize, const delete_operator_t delete_op);
+
+
+/**
+ * @brief number of elements pushed and not yet merged
+ * @note complexity: O(1)
+ * @param es the sorter
+ * @return the number of elements on success, SIZE_MAX on failure
+ */
+size_t external_sort__length(const ExternalSort es);
+
+
+/**
+ * @brief number of runs written to temporary files
+ * @note complexity: O(1)
+ * @param es the sorter
+ * @return the number of runs on success, SIZE_MAX on failure
+ */
+size_t external_sort__n_runs(const ExternalSort es);
+
+
+/**
+ * @brief pushes an element in the sorter, which takes its ownership
+ * @details when the buffer is full, it is sorted and written to a new run
+ * @note complexity: O(1) amortized, O(run_length*log(run_length)) when a run is written
+ * @param es the sorter
+ * @param element the element, not NULL
+ * @return 0 on success, -1 on failure
+ */
+char external_sort__push(const ExternalSort es, const elem_t element);
+
+
+/**
+ * @brief dequeues all elements of the queue and pushes them in the sorter
+ * @details the sorter takes the ownership of the dequeued elements
+ * @note complexity: O(n*log(run_length))
+ * @param es the sorter
+ * @param q the queue
+ * @return 0 on success, -1 on failure
+ */
+char external_sort__push_queue(const ExternalSort es, const Queue q);
+
+
+/**
+ * @brief outputs all elements in sorted order to the given function
+ * @details every element is deleted once the function returns. The sorter is left empty, on failure the
+ * elements not yet output are deleted
+ * @note complexity: O(n*log(n))
+ * @param es the sorter
+ * @param func the function applied on every element
+ * @param user_data the user data given to the function
+ * @return 0 on success, -1 on failure
+ */
+char external_sort__merge(const ExternalSort es, const applying_func_t func, void *user_data);
+
+
+/**
+ * @brief enqueues all elements in sorted order in the queue
+ * @details a queue with copy disabled takes the ownership of the elements, a queue with copy enabled
+ * stores copies and the sorted elements are deleted. The sorter is left empty, on failure the
+ * elements not yet enqueued are deleted
+ * @note complexity: O(n*log(n))
+ * @param es the sorter
+ * @param q the output queue
+ * @return 0 on success, -1 on failure
+ */
+char external_sort__merge_into(const ExternalSort es, const Queue q);
+
+
+/**
+ * @brief frees all allocated memory used by the sorter, deletes the pending elements and removes the runs
+ * @note complexity: O(n)
+ * @param es the sorter
+ */
+void external_sort__free(const ExternalSort es);
+
+
+#endif
@@ -0,0 +1,211 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "intern.h"
+
+#define DEFAULT_INTERN_CAPACITY 16
+#define DEFAULT_BLOCK_SIZE 4096
+
+///////////////////////////////////////////////////////////////////////////////
+///     INTERN TABLE STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    const char *str;
+    size_t length;
+    uint64_t hash;
+} InternEntry;
+
+struct InternBlockSt
+{
+    struct InternBlockSt *next;
+    size_t used;
+    size_t size;
+    char bytes[];
+};
+
+struct InternTableSt
+{
+    InternEntry *entries;
+    size_t length;
+    size_t capacity;
+    struct InternBlockSt *blocks;
+    pthread_rwlock_t lock;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     INTERN TABLE UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * FNV-1a hash of the given bytes
+ */
+static inline uint64_t hash_bytes(const char *str, const size_t len) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char)str[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * Position of the entry holding the string, or of the empty entry where it belongs
+ */
+static inline size_t entry_find(const InternTable t, const char *str, const size_t len, const uint64_t hash) {
+    size_t mask = t->capacity - 1;
+    size_t i = (size_t)hash & mask;
+    const InternEntry *entry;
+
+    for (;;) {
+        entry = t->entries + i;
+        if (!entry->str) return i;
+        if (entry->hash == hash && entry->length == len && !memcmp(entry->str, str, len)) return i;
+        i = (i + 1) & mask;
+    }
+}
+
+static char table_grow(const InternTable t) {
+    size_t capacity = t->capacity<<1;
+    size_t mask = capacity - 1;
+    size_t j;
+
+    InternEntry *entries = calloc(capacity, sizeof(InternEntry));
+    if (!entries) return FAILURE;
+
+    for (size_t i = 0; i < t->capacity; i++) {
+        if (!t->entries[i].str) continue;
+        j = (size_t)t->entries[i].hash & mask;
+        while (entries[j].str) j = (j + 1) & mask;
+        entries[j] = t->entries[i];
+    }
+
+    free(t->entries);
+    t->entries = entries;
+    t->capacity = capacity;
+
+    return SUCCESS;
+}
+
+/**
+ * Copies the string in the current block, the bytes of a block never move
+ */
+static const char *block_store(const InternTable t, const char *str, const size_t len) {
+    struct InternBlockSt *block = t->blocks;
+
+    if (!block || block->size - block->used < len + 1) {
+        size_t size = len + 1 > DEFAULT_BLOCK_SIZE ? len + 1 : DEFAULT_BLOCK_SIZE;
+        block = malloc(sizeof(struct InternBlockSt) + size);
+        if (!block) return NULL;
+        block->next = t->blocks;
+        block->used = 0;
+        block->size = size;
+        t->blocks = block;
+    }
+
+    char *res = block->bytes + block->used;
+    memcpy(res, str, len);
+    res[len] = '\0';
+    block->used += len + 1;
+
+    return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     INTERN TABLE FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+InternTable intern__empty(void) {
+    InternTable t = malloc(sizeof(struct InternTableSt));
+    if (!t) return NULL;
+
+    t->entries = calloc(DEFAULT_INTERN_CAPACITY, sizeof(InternEntry));
+    if (!t->entries || pthread_rwlock_init(&t->lock, NULL)) {
+        free(t->entries);
+        free(t);
+        return NULL;
+    }
+
+    t->length = 0;
+    t->capacity = DEFAULT_INTERN_CAPACITY;
+    t->blocks = NULL;
+
+    return t;
+}
+
+size_t intern__length(const InternTable t) {
+    if (!t) return SIZE_MAX;
+
+    pthread_rwlock_rdlock(&t->lock);
+    size_t length = t->length;
+    pthread_rwlock_unlock(&t->lock);
+
+    return length;
+}
+
+const char *intern__get(const InternTable t, const char *str) {
+    if (!t || !str) return NULL;
+
+    return intern__get_n(t, str, strlen(str));
+}
+
+const char *intern__get_n(const InternTable t, const char *str, const size_t len) {
+    if (!t || !str) return NULL;
+
+    uint64_t hash = hash_bytes(str, len);
+    const char *res;
+    size_t i;
+
+    pthread_rwlock_rdlock(&t->lock);
+    res = t->entries[entry_find(t, str, len, hash)].str;
+    pthread_rwlock_unlock(&t->lock);
+    if (res) return res;
+
+    pthread_rwlock_wrlock(&t->lock);
+    i = entry_find(t, str, len, hash);
+    res = t->entries[i].str;
+    if (!res && ((t->length + 1)<<1 <= t->capacity || table_grow(t) == SUCCESS)) {
+        i = entry_find(t, str, len, hash);
+        if ((res = block_store(t, str, len))) {
+            t->entries[i].str = res;
+            t->entries[i].length = len;
+            t->entries[i].hash = hash;
+            t->length++;
+        }
+    }
+    pthread_rwlock_unlock(&t->lock);
+    return res;
+}
+
+const char *intern__lookup(const InternTable t, const char *str) {
+    if (!t || !str) return NULL;
+
+    size_t len = strlen(str);
+    uint64_t hash = hash_bytes(str, len);
+
+    pthread_rwlock_rdlock(&t->lock);
+    const char *res = t->entries[entry_find(t, str, len, hash)].str;
+    pthread_rwlock_unlock(&t->lock);
+
+    return res;
+}
+
+void intern__free(const InternTable t) {
+    if (!t) return;
+
+    struct InternBlockSt *block = t->blocks;
+    struct InternBlockSt *next;
+    while (block) {
+        next = block->next;
+        free(block);
+        block = next;
+    }
+
+    pthread_rwlock_destroy(&t->lock);
+    free(t->entries);
+    free(t);
+}
@@ -0,0 +1,82 @@
+#ifndef __INTERN_H__
+#define __INTERN_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a string interning table
+ *
+ * Notes :
+ * 1) The table returns a single stable pointer per distinct string: interning two equal strings
+ * gives the same pointer, which stays valid until the table is freed. Containers with copy disabled
+ * can therefore hold interned strings and compare them by pointer ('queue__ptr_contains', 'stack__ptr_search').
+ *
+ * 2) All functions can be called concurrently from several threads, lookups of strings already
+ * interned only take a shared lock.
+ *
+ * 3) Interned strings are never removed, their memory is released by 'intern__free'.
+ */
+typedef struct InternTableSt * InternTable;
+
+
+/**
+ * @brief create an empty interning table
+ * @note complexity: O(1)
+ * @return a pointer to table on success, NULL on failure
+ */
+InternTable intern__empty(void);
+
+
+/**
+ * @brief number of distinct strings in the table
+ * @note complexity: O(1)
+ * @param t the table
+ * @return the number of strings contained in the table on success, SIZE_MAX on failure
+ */
+size_t intern__length(const InternTable t);
+
+
+/**
+ * @brief retrieves the interned pointer of a NUL-terminated string, interning it if needed
+ * @note complexity: O(m) expected where m is the length of the string
+ * @param t the table
+ * @param str the string
+ * @return the interned string on success, NULL on failure
+ */
+const char *intern__get(const InternTable t, const char *str);
+
+
+/**
+ * @brief retrieves the interned pointer of the first 'len' bytes of a string, interning them if needed
+ * @details the interned string is NUL-terminated
+ * @note complexity: O(len) expected
+ * @param t the table
+ * @param str the string
+ * @param len number of bytes
+ * @return the interned string on success, NULL on failure
+ */
+const char *intern__get_n(const InternTable t, const char *str, const size_t len);
+
+
+/**
+ * @brief retrieves the interned pointer of a NUL-terminated string without interning it
+ * @note complexity: O(m) expected where m is the length of the string
+ * @param t the table
+ * @param str the string
+ * @return the interned string if the string is in the table, NULL if not, NULL on failure
+ */
+const char *intern__lookup(const InternTable t, const char *str);
+
+
+/**
+ * @brief frees all allocated memory used by the table, including the interned strings
+ * @note complexity: O(n)
+ * @param t the table
+ */
+void intern__free(const InternTable t);
+
+
+#endif
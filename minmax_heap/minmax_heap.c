@@ -0,0 +1,288 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minmax_heap.h"
+#include "../common/alloc.h"
+#include "../common/vec.h"
+
+#define DEFAULT_HEAP_CAPACITY 4
+
+///////////////////////////////////////////////////////////////////////////////
+///     MINMAX HEAP STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+struct MinMaxHeapSt
+{
+    elem_t *elems;
+    size_t back;
+    size_t length;
+    size_t capacity;
+    compare_func_t cmp;
+    char copy_enabled;
+    copy_operator_t operator_copy;
+    delete_operator_t operator_delete;
+} CACHE_ALIGNED;
+
+///////////////////////////////////////////////////////////////////////////////
+///     MINMAX HEAP MACRO UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+static inline elem_t id(elem_t e) {
+    return e;
+}
+
+static inline void skip(elem_t e) {
+    return;
+}
+
+/**
+ * Macro to allocate all memory used by the heap
+ */
+#define HEAP_INIT(__cmp, __copy_op, __delete_op, __n_elems) \
+({ \
+    MinMaxHeap __ptr = alloc__control(sizeof(struct MinMaxHeapSt)); \
+    if (__ptr) { \
+        __ptr->elems = alloc__elems(__n_elems); \
+        if (__ptr->elems) { \
+            __ptr->back = 0; \
+            __ptr->length = 0; \
+            __ptr->capacity = (__n_elems); \
+            __ptr->cmp = (__cmp); \
+            __ptr->copy_enabled = __copy_op ? true : false; \
+            __ptr->operator_copy = __copy_op ? __copy_op : id; \
+            __ptr->operator_delete = __delete_op ? __delete_op : skip; \
+        } else { \
+            free(__ptr); \
+            __ptr = NULL; \
+        } \
+    } \
+    __ptr; \
+})
+
+#define PARENT(__i) (((__i) - 1) / 2)
+
+#define GRANDPARENT(__i) (((__i) - 3) / 4)
+
+/**
+ * Macro to check if the position is on a min level, levels are numbered from 0 at the root
+ */
+#define IS_MIN_LEVEL(__i) \
+    (!((63 - __builtin_clzll((unsigned long long)(__i) + 1)) & 1))
+
+///////////////////////////////////////////////////////////////////////////////
+///     MINMAX HEAP UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Returns true if the element at i must be above the element at j on a level of the given kind
+ */
+static inline char precedes(const MinMaxHeap h, const size_t i, const size_t j, const char min_level) {
+    int c = h->cmp(h->elems + i, h->elems + j);
+    return min_level ? c < 0 : c > 0;
+}
+
+static inline void swap_slots(const MinMaxHeap h, const size_t i, const size_t j) {
+    elem_t tmp = h->elems[i];
+    h->elems[i] = h->elems[j];
+    h->elems[j] = tmp;
+}
+
+/**
+ * Moves the element at i up through the levels of its own kind
+ */
+static void bubble_up_grandparents(const MinMaxHeap h, size_t i, const char min_level) {
+    while (i > 2 && precedes(h, i, GRANDPARENT(i), min_level)) {
+        swap_slots(h, i, GRANDPARENT(i));
+        i = GRANDPARENT(i);
+    }
+}
+
+static void bubble_up(const MinMaxHeap h, size_t i) {
+    if (!i) return;
+
+    char min_level = IS_MIN_LEVEL(i);
+    size_t p = PARENT(i);
+
+    if (precedes(h, p, i, min_level)) {
+        swap_slots(h, i, p);
+        bubble_up_grandparents(h, p, !min_level);
+    } else {
+        bubble_up_grandparents(h, i, min_level);
+    }
+}
+
+/**
+ * Moves the element at i down through the levels of its own kind, fixing its parent on the way
+ */
+static void trickle_down(const MinMaxHeap h, size_t i) {
+    const char min_level = IS_MIN_LEVEL(i);
+    const size_t n = h->length;
+    size_t m, first, last;
+
+    while ((first = 2 * i + 1) < n) {
+        m = first;
+        if (first + 1 < n && precedes(h, first + 1, m, min_level)) m = first + 1;
+
+        last = 4 * i + 7 < n ? 4 * i + 7 : n;
+        for (size_t g = 4 * i + 3; g < last; g++) {
+            if (precedes(h, g, m, min_level)) m = g;
+        }
+
+        if (!precedes(h, m, i, min_level)) return;
+
+        swap_slots(h, m, i);
+        if (m <= first + 1) return;
+
+        if (precedes(h, PARENT(m), m, min_level)) swap_slots(h, m, PARENT(m));
+        i = m;
+    }
+}
+
+/**
+ * Position of the maximum element, one of the children of the root
+ */
+static inline size_t max_position(const MinMaxHeap h) {
+    if (h->length < 3) return h->length - 1;
+
+    return h->cmp(h->elems + 1, h->elems + 2) >= 0 ? 1 : 2;
+}
+
+/**
+ * Replaces the element at i by the last one and restores the heap, the removed element is returned
+ */
+static elem_t remove_at(const MinMaxHeap h, const size_t i) {
+    elem_t res = h->elems[i];
+    size_t new_capacity;
+
+    h->back--;
+    h->length--;
+
+    if (i < h->length) {
+        h->elems[i] = h->elems[h->length];
+        trickle_down(h, i);
+    }
+
+    new_capacity = h->capacity>>1;
+    if (h->length < new_capacity && new_capacity >= DEFAULT_HEAP_CAPACITY) {
+        RESIZE(h, new_capacity);
+    }
+
+    return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     MINMAX HEAP FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+MinMaxHeap minmax_heap__empty_copy_disabled(const compare_func_t cmp) {
+    if (!cmp) return NULL;
+
+    return HEAP_INIT(cmp, NULL, NULL, DEFAULT_HEAP_CAPACITY);
+}
+
+MinMaxHeap minmax_heap__empty_copy_enabled(const compare_func_t cmp, const copy_operator_t copy_op, const delete_operator_t delete_op) {
+    if (!cmp || !copy_op || !delete_op) return NULL;
+
+    return HEAP_INIT(cmp, copy_op, delete_op, DEFAULT_HEAP_CAPACITY);
+}
+
+inline char minmax_heap__is_copy_enabled(const MinMaxHeap h) {
+    return !h ? FAILURE : h->copy_enabled;
+}
+
+inline char minmax_heap__is_empty(const MinMaxHeap h) {
+    return !h ? FAILURE : !h->length;
+}
+
+inline size_t minmax_heap__length(const MinMaxHeap h) {
+    return !h ? SIZE_MAX : h->length;
+}
+
+char minmax_heap__push(const MinMaxHeap h, const elem_t element) {
+    if (!h) return FAILURE;
+
+    if (ENSURE_CAPACITY(h) < 0) return FAILURE;
+
+    h->elems[h->length] = h->operator_copy(element);
+    h->back++;
+    h->length++;
+
+    bubble_up(h, h->length - 1);
+
+    return SUCCESS;
+}
+
+char minmax_heap__pop_min(const MinMaxHeap h, elem_t *min) {
+    if (!h || !h->length) return FAILURE;
+
+    elem_t elem = remove_at(h, 0);
+
+    if (min) {
+        *min = elem;
+    } else {
+        h->operator_delete(elem);
+    }
+
+    return SUCCESS;
+}
+
+char minmax_heap__pop_max(const MinMaxHeap h, elem_t *max) {
+    if (!h || !h->length) return FAILURE;
+
+    elem_t elem = remove_at(h, max_position(h));
+
+    if (max) {
+        *max = elem;
+    } else {
+        h->operator_delete(elem);
+    }
+
+    return SUCCESS;
+}
+
+char minmax_heap__peek_min(const MinMaxHeap h, elem_t *min) {
+    if (!h || !h->length || !min) return FAILURE;
+
+    *min = h->operator_copy(h->elems[0]);
+
+    return SUCCESS;
+}
+
+char minmax_heap__peek_max(const MinMaxHeap h, elem_t *max) {
+    if (!h || !h->length || !max) return FAILURE;
+
+    *max = h->operator_copy(h->elems[max_position(h)]);
+
+    return SUCCESS;
+}
+
+char minmax_heap__from_array(const MinMaxHeap h, void *A, const size_t n_elems, const size_t size) {
+    if (!h || !A) return FAILURE;
+
+    if (h->back + n_elems > h->capacity && RESIZE(h, h->back + n_elems) < 0) return FAILURE;
+
+    FROM_ARRAY(h, A, n_elems, size);
+
+    for (size_t i = h->length / 2; i > 0; i--) {
+        trickle_down(h, i - 1);
+    }
+
+    return SUCCESS;
+}
+
+void minmax_heap__clear(const MinMaxHeap h) {
+    if (!h) return;
+
+    FREE_ELEMS(h, 0, h->length);
+    RESIZE(h, DEFAULT_HEAP_CAPACITY);
+}
+
+void minmax_heap__free(const MinMaxHeap h) {
+    if (!h) return;
+
+    FREE_ELEMS(h, 0, h->length);
+
+    free(h->elems);
+    free(h);
+}
@@ -0,0 +1,162 @@
+#ifndef __MINMAX_HEAP_H__
+#define __MINMAX_HEAP_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a double-ended priority queue as a min-max heap
+ *
+ * Notes :
+ * 1) You have to correctly implement copy and delete operators
+ * by handling NULL value, otherwise you can end up with an undefined behaviour.
+ * The prototypes of these functions are:
+ * elem_t (*copy_op)(elem_t)
+ * void (*delete_op)(elem_t)
+ *
+ * 2) The heap is stored in a single array whose levels alternate between min and max levels, the root being
+ * on a min level. Every element is not greater than its descendants on a min level and not less than them
+ * on a max level: the minimum is the root and the maximum one of its children.
+ *
+ * 3) The compare function receives pointers to elements, as with qsort.
+ *
+ * 4) 'minmax_heap__peek_min' and 'minmax_heap__peek_max' return a copy of the element, 'minmax_heap__pop_min'
+ * and 'minmax_heap__pop_max' return the element itself. The user has to manually free them after usage.
+ */
+typedef struct MinMaxHeapSt * MinMaxHeap;
+
+
+/**
+ * @brief create an empty min-max heap with copy disabled
+ * @note complexity: O(1)
+ * @param cmp the compare function
+ * @return a pointer to the heap on success, NULL on failure
+ */
+MinMaxHeap minmax_heap__empty_copy_disabled(const compare_func_t cmp);
+
+
+/**
+ * @brief create an empty min-max heap with copy enabled
+ * @note complexity: O(1)
+ * @param cmp the compare function
+ * @param copy_op copy operator
+ * @param delete_op delete operator
+ * @return a pointer to the heap on success, NULL on failure
+ */
+MinMaxHeap minmax_heap__empty_copy_enabled(const compare_func_t cmp, const copy_operator_t copy_op, const delete_operator_t delete_op);
+
+
+/**
+ * @brief checks if the heap has the copy operator enabled
+ * @note complexity: O(1)
+ * @param h the heap
+ * @return 1 if the heap has copy enabled, 0 if not, -1 on failure
+ */
+char minmax_heap__is_copy_enabled(const MinMaxHeap h);
+
+
+/**
+ * @brief checks if the heap is empty
+ * @note complexity: O(1)
+ * @param h the heap
+ * @return 1 if the heap is empty, 0 if not, -1 on failure
+ */
+char minmax_heap__is_empty(const MinMaxHeap h);
+
+
+/**
+ * @brief number of elements in the heap
+ * @note complexity: O(1)
+ * @param h the heap
+ * @return the number of elements on success, SIZE_MAX on failure
+ */
+size_t minmax_heap__length(const MinMaxHeap h);
+
+
+/**
+ * @brief pushes an element in the heap
+ * @note complexity: O(log(n))
+ * @param h the heap
+ * @param element the element
+ * @return 0 on success, -1 on failure
+ */
+char minmax_heap__push(const MinMaxHeap h, const elem_t element);
+
+
+/**
+ * @brief removes the minimum element of the heap
+ * @details the element is stored in 'min' variable and must be manually freed by user afterward,
+ * it is deleted if 'min' is NULL
+ * @note complexity: O(log(n))
+ * @param h the heap
+ * @param min pointer to storage variable, can be NULL
+ * @return 0 on success, -1 on failure
+ */
+char minmax_heap__pop_min(const MinMaxHeap h, elem_t *min);
+
+
+/**
+ * @brief removes the maximum element of the heap
+ * @details the element is stored in 'max' variable and must be manually freed by user afterward,
+ * it is deleted if 'max' is NULL
+ * @note complexity: O(log(n))
+ * @param h the heap
+ * @param max pointer to storage variable, can be NULL
+ * @return 0 on success, -1 on failure
+ */
+char minmax_heap__pop_max(const MinMaxHeap h, elem_t *max);
+
+
+/**
+ * @brief retrieve a copy of the minimum element of the heap without removing it
+ * @note complexity: O(1)
+ * @param h the heap
+ * @param min pointer to storage variable
+ * @return 0 on success, -1 on failure
+ */
+char minmax_heap__peek_min(const MinMaxHeap h, elem_t *min);
+
+
+/**
+ * @brief retrieve a copy of the maximum element of the heap without removing it
+ * @note complexity: O(1)
+ * @param h the heap
+ * @param max pointer to storage variable
+ * @return 0 on success, -1 on failure
+ */
+char minmax_heap__peek_max(const MinMaxHeap h, elem_t *max);
+
+
+/**
+ * @brief adds the elements of an array to the heap
+ * @details the slots of the array are given to the copy operator, a heap with copy disabled stores pointers
+ * to the slots. The whole heap is rebuilt bottom-up instead of pushing the elements one by one
+ * @note complexity: O(n + n_elems)
+ * @param h the heap
+ * @param A the array
+ * @param n_elems number of elements of the array
+ * @param size size of an element of the array
+ * @return 0 on success, -1 on failure
+ */
+char minmax_heap__from_array(const MinMaxHeap h, void *A, const size_t n_elems, const size_t size);
+
+
+/**
+ * @brief removes all elements of the heap
+ * @note complexity: O(n)
+ * @param h the heap
+ */
+void minmax_heap__clear(const MinMaxHeap h);
+
+
+/**
+ * @brief frees all allocated memory used by the heap
+ * @note complexity: O(n)
+ * @param h the heap
+ */
+void minmax_heap__free(const MinMaxHeap h);
+
+
+#endif
@@ -3,7 +3,12 @@
 #include <string.h>
 
 #include "queue.h"
+#include "../common/alloc.h"
 #include "../common/vec.h"
+#include "../common/reclaimer.h"
+#include "../common/sort.h"
+#include "../common/sample.h"
+#include "../common/hash_index.h"
 
 #define DEFAULT_QUEUE_CAPACITY 2
 
@@ -18,10 +23,19 @@ struct QueueSt
     size_t back;
     size_t length;
     size_t capacity;
+    elem_t *old_elems;
+    size_t old_shift;
+    size_t old_end;
+    size_t migrated;
+    char incremental;
+    char reversed;
+    compare_func_t sorted_by;
+    HashIndex index;
+    size_t index_head;
     char copy_enabled;
     copy_operator_t operator_copy;
     delete_operator_t operator_delete;
-};
+} CACHE_ALIGNED;
 
 ///////////////////////////////////////////////////////////////////////////////
 ///     QUEUE MACRO UTILITARIES
@@ -40,14 +54,23 @@ static inline void skip(elem_t e) {
  */
 #define QUEUE_INIT(__copy_op, __delete_op, __n_elems) \
 ({ \
-    Queue __ptr = malloc(sizeof(struct QueueSt)); \
+    Queue __ptr = alloc__control(sizeof(struct QueueSt)); \
     if (__ptr) { \
-        __ptr->elems = malloc(sizeof(elem_t) * (__n_elems)); \
+        __ptr->elems = alloc__elems(__n_elems); \
         if (__ptr->elems) { \
             __ptr->front = 0; \
             __ptr->back = 0; \
             __ptr->length = 0; \
             __ptr->capacity = (__n_elems); \
+            __ptr->old_elems = NULL; \
+            __ptr->old_shift = 0; \
+            __ptr->old_end = 0; \
+            __ptr->migrated = 0; \
+            __ptr->incremental = false; \
+            __ptr->reversed = false; \
+            __ptr->sorted_by = NULL; \
+            __ptr->index = NULL; \
+            __ptr->index_head = 0; \
             __ptr->copy_enabled = __copy_op ? true : false; \
             __ptr->operator_copy = __copy_op ? __copy_op : id; \
             __ptr->operator_delete = __delete_op ? __delete_op : skip; \
@@ -67,6 +90,44 @@ static inline void skip(elem_t e) {
     __ptr->front = 0; \
     __ptr->back = __ptr->length
 
+/**
+ * Makes room before the front, where a reversed queue enqueues
+ */
+static char make_front_room(const Queue q) {
+    size_t front = q->incremental ? INCREMENTAL_RECENTER(q, q->front, DEFAULT_QUEUE_CAPACITY) : RECENTER(q, q->front);
+    if (front == SIZE_MAX) return FAILURE;
+
+    q->front = front;
+
+    return SUCCESS;
+}
+
+/**
+ * Sequence number in the index of the element at position i
+ */
+#define INDEX_SEQ(__ptr, __i) \
+    ((__ptr)->index_head + (__i) - (__ptr)->front)
+
+/**
+ * Re-indexes all elements after their positions changed, the index is dropped if it can not grow
+ */
+static void index_rebuild(const Queue q) {
+    if (!q->index) return;
+
+    hash_index__clear(q->index);
+    q->index_head = 0;
+
+    if (hash_index__reserve(q->index, q->length) < 0) {
+        hash_index__free(q->index);
+        q->index = NULL;
+        return;
+    }
+
+    for (size_t i = q->front; i < q->back; i++) {
+        hash_index__insert(q->index, q->elems[i], INDEX_SEQ(q, i));
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///     QUEUE FUNCTIONS TO EXPORT
 ///////////////////////////////////////////////////////////////////////////////
@@ -93,15 +154,63 @@ inline size_t queue__length(const Queue q) {
     return !q ? SIZE_MAX : q->length;
 }
 
+char queue__set_incremental_resize(const Queue q, const char enabled) {
+    if (!q) return FAILURE;
+
+    if (!enabled) {
+        MIGRATE_ALL(q, q->front);
+    }
+    q->incremental = enabled ? true : false;
+
+    return SUCCESS;
+}
+
+char queue__set_index(const Queue q, const key_func_t hash, const compare_func_t match) {
+    if (!q || (hash && !match)) return FAILURE;
+
+    hash_index__free(q->index);
+    q->index = NULL;
+    if (!hash) return SUCCESS;
+
+    MIGRATE_ALL(q, q->front);
+    MATERIALIZE(q, q->front, q->back);
+
+    if (!(q->index = hash_index__empty(hash, match))) return FAILURE;
+    index_rebuild(q);
+
+    return q->index ? SUCCESS : FAILURE;
+}
+
 char queue__enqueue(const Queue q, const elem_t element) {
     if (!q) return FAILURE;
 
-    if (ENSURE_CAPACITY(q) < 0) return FAILURE;
+    if (q->index && hash_index__reserve(q->index, q->length + 1) < 0) return FAILURE;
 
-    q->elems[q->back] = q->operator_copy(element);
+    if (q->reversed) {
+        if (!q->front && make_front_room(q) < 0) return FAILURE;
+        q->front--;
+        SLOT(q, q->front) = q->operator_copy(element);
+        q->length++;
+        MIGRATE(q, q->front, MIGRATE_STEP);
+        return SUCCESS;
+    }
+
+    if (q->incremental && q->back == q->capacity) {
+        if (INCREMENTAL_GROW(q, q->front, DEFAULT_QUEUE_CAPACITY) < 0) return FAILURE;
+        q->front = 0;
+    } else if (ENSURE_CAPACITY(q) < 0) return FAILURE;
+
+    SLOT(q, q->back) = q->operator_copy(element);
+    hash_index__insert(q->index, SLOT(q, q->back), INDEX_SEQ(q, q->back));
     q->back++;
     q->length++;
 
+    if (q->sorted_by && q->length > 1 && q->sorted_by(&SLOT(q, q->back - 2), &SLOT(q, q->back - 1)) > 0) {
+        q->sorted_by = NULL;
+    }
+
+    MIGRATE(q, q->front, MIGRATE_STEP);
+
     return SUCCESS;
 }
 
@@ -109,15 +218,34 @@ char queue__dequeue(const Queue q, elem_t *front) {
     size_t new_capacity;
     if (!q || !q->length) return FAILURE;
 
+    hash_index__remove(q->index, SLOT(q, q->front), q->index_head);
+    q->index_head++;
+
+    size_t pos = ORIENT(q, q->front, q->back, q->front);
     if (front) {
-        *front = q->elems[q->front];
+        *front = SLOT(q, pos);
     } else {
-        q->operator_delete(q->elems[q->front]);
+        q->operator_delete(SLOT(q, pos));
     }
 
-    q->front++;
+    if (q->reversed) {
+        q->back--;
+    } else {
+        q->front++;
+    }
     q->length--;
 
+    if (q->incremental) {
+        MIGRATE(q, q->front, MIGRATE_STEP);
+        new_capacity = q->capacity>>1;
+        if (!q->old_elems && q->length < new_capacity>>1 && new_capacity >= DEFAULT_QUEUE_CAPACITY
+                && !REBASE(q, q->front, new_capacity)) {
+            q->front = 0;
+            MIGRATE(q, q->front, MIGRATE_STEP);
+        }
+        return SUCCESS;
+    }
+
     new_capacity = q->capacity>>1;
     if (q->length < new_capacity && new_capacity >= DEFAULT_QUEUE_CAPACITY) {
         QUEUE_SHIFT(q);
@@ -128,10 +256,13 @@ char queue__dequeue(const Queue q, elem_t *front) {
 }
 
 char queue__remove_nth(const Queue q, const size_t i) {
-    if (!q || i >= q->length) return FAILURE;
+    if (!q || i < q->front || i >= q->back) return FAILURE;
 
-    q->operator_delete(q->elems[i]);
-    q->elems[i] = NULL;
+    size_t k = ORIENT(q, q->front, q->back, i);
+    hash_index__remove(q->index, SLOT(q, k), INDEX_SEQ(q, k));
+    q->operator_delete(SLOT(q, k));
+    SLOT(q, k) = NULL;
+    q->sorted_by = NULL;
 
     return SUCCESS;
 }
@@ -139,7 +270,7 @@ char queue__remove_nth(const Queue q, const size_t i) {
 char queue__peek_front(const Queue q, elem_t *front) {
     if (!q || !q->length || !front) return FAILURE;
 
-    *front = q->operator_copy(q->elems[q->front]);
+    *front = q->operator_copy(SLOT(q, ORIENT(q, q->front, q->back, q->front)));
 
     return SUCCESS;
 }
@@ -147,7 +278,7 @@ char queue__peek_front(const Queue q, elem_t *front) {
 char queue__peek_back(const Queue q, elem_t *back) {
     if (!q || !q->length || !back) return FAILURE;
 
-    *back = q->operator_copy(q->elems[q->back - 1]);
+    *back = q->operator_copy(SLOT(q, ORIENT(q, q->front, q->back, q->back - 1)));
 
     return SUCCESS;
 }
@@ -155,7 +286,7 @@ char queue__peek_back(const Queue q, elem_t *back) {
 char queue__peek_nth(const Queue q, const size_t i, elem_t *nth) {
     if (!q || !q->length || !nth || i < q->front || i >= q->back) return FAILURE;
 
-    *nth = q->operator_copy(q->elems[i]);
+    *nth = q->operator_copy(SLOT(q, ORIENT(q, q->front, q->back, i)));
 
     return SUCCESS;
 }
@@ -163,7 +294,17 @@ char queue__peek_nth(const Queue q, const size_t i, elem_t *nth) {
 char queue__swap(const Queue q, const size_t i, const size_t j) {
     if (!q || i < q->front || i >= q->back || j < q->front || j >= q->back) return FAILURE;
 
-    SWAP(q, i, j);
+    if (i == j) return SUCCESS;
+
+    q->sorted_by = NULL;
+
+    hash_index__remove(q->index, SLOT(q, i), INDEX_SEQ(q, i));
+    hash_index__remove(q->index, SLOT(q, j), INDEX_SEQ(q, j));
+
+    SWAP(q, ORIENT(q, q->front, q->back, i), ORIENT(q, q->front, q->back, j));
+
+    hash_index__insert(q->index, SLOT(q, i), INDEX_SEQ(q, i));
+    hash_index__insert(q->index, SLOT(q, j), INDEX_SEQ(q, j));
 
     return SUCCESS;
 }
@@ -171,6 +312,8 @@ char queue__swap(const Queue q, const size_t i, const size_t j) {
 Queue queue__copy(const Queue q) {
     if (!q) return NULL;
 
+    MIGRATE_ALL(q, q->front);
+
     Queue copy = QUEUE_INIT(q->operator_copy, q->operator_delete, q->length);
     if (!copy) return NULL;
 
@@ -178,6 +321,14 @@ Queue queue__copy(const Queue q) {
 
     copy->front = 0;
     copy->back = q->length;
+    copy->incremental = q->incremental;
+    copy->reversed = q->reversed;
+    copy->sorted_by = q->sorted_by;
+
+    if (q->index && queue__set_index(copy, hash_index__hash(q->index), hash_index__match(q->index)) < 0) {
+        queue__free(copy);
+        return NULL;
+    }
 
     return copy;
 }
@@ -188,10 +339,14 @@ Queue queue__from_array(Queue q, void *A, const size_t n_elems, const size_t siz
     if (!q) {
         if (!(q = QUEUE_INIT(NULL, NULL, n_elems))) return NULL;
     } else {
+        MIGRATE_ALL(q, q->front);
+        MATERIALIZE(q, q->front, q->back);
         if (RESIZE(q, q->back + n_elems) < 0) return NULL;
     }
 
     FROM_ARRAY(q, A, n_elems, size);
+    q->sorted_by = NULL;
+    index_rebuild(q);
 
     return q;
 }
@@ -199,11 +354,15 @@ Queue queue__from_array(Queue q, void *A, const size_t n_elems, const size_t siz
 elem_t *queue__dump(const Queue q) {
     if (!q || !q->length) return NULL;
 
+    MIGRATE_ALL(q, q->front);
+    MATERIALIZE(q, q->front, q->back);
+
     elem_t *res = malloc(sizeof(elem_t) * q->length);
     if (!res) return NULL;
 
     memcpy(res, q->elems + q->front, sizeof(elem_t) * q->length);
     RESIZE(q, DEFAULT_QUEUE_CAPACITY);
+    hash_index__clear(q->index);
 
     q->front = 0;
     q->back = 0;
@@ -215,6 +374,9 @@ elem_t *queue__dump(const Queue q) {
 elem_t *queue__to_array(const Queue q) {
     if (!q || !q->length) return NULL;
 
+    MIGRATE_ALL(q, q->front);
+    MATERIALIZE(q, q->front, q->back);
+
     elem_t *res = malloc(sizeof(elem_t) * q->length);
     if (!res) return NULL;
 
@@ -234,95 +396,240 @@ elem_t *queue__to_array(const Queue q) {
 size_t queue__ptr_search(const Queue q, const elem_t elem) {
     if (!q) return SIZE_MAX;
 
+    MIGRATE_ALL(q, q->front);
+
     return PTR_SEARCH(q, q->front, q->back, elem);
 }
 
 size_t queue__search(const Queue q, const elem_t elem, const compare_func_t match) {
     if (!q || !match) return SIZE_MAX;
 
+    if (elem && q->index && match == hash_index__match(q->index)) {
+        size_t seq = hash_index__find(q->index, elem);
+        return seq == SIZE_MAX ? SIZE_MAX : q->front + seq - q->index_head;
+    }
+
+    MIGRATE_ALL(q, q->front);
+
     return SEARCH(q, q->front, q->back, elem, match);
 }
 
 char queue__ptr_contains(const Queue q, const elem_t elem) {
     if (!q) return FAILURE;
 
+    MIGRATE_ALL(q, q->front);
+
     return PTR_SEARCH(q, q->front, q->back, elem) != SIZE_MAX;
 }
 
 char queue__contains(const Queue q, const elem_t elem, const compare_func_t match) {
     if (!q || !match) return FAILURE;
 
+    if (elem && q->index && match == hash_index__match(q->index)) {
+        return hash_index__find(q->index, elem) != SIZE_MAX;
+    }
+
+    MIGRATE_ALL(q, q->front);
+
     return SEARCH(q, q->front, q->back, elem, match) != SIZE_MAX;
 }
 
 char queue__cmp(const Queue q, const Queue w, const compare_func_t match) {
     if (!q || !w || !match) return FAILURE;
 
+    MIGRATE_ALL(q, q->front);
+    MIGRATE_ALL(w, w->front);
+
     if (q == w) return true;
     if (q->length != w->length) return false;
 
-    return ARRAY_CMP(q->elems + q->front, w->elems + w->front, match, q->length);
+    return RANGE_CMP(q, q->front, q->back, w, w->front, w->back, match);
 }
 
 void queue__foreach(const Queue q, const applying_func_t func, void *user_data) {
     if (!q || !func) return;
 
+    MIGRATE_ALL(q, q->front);
+
     FOREACH(q, func, user_data, q->front, q->back);
 }
 
 void queue__filter(const Queue q, const filter_func_t pred, void *user_data) {
     if (!q || !pred) return;
 
+    MIGRATE_ALL(q, q->front);
+
     FILTER(q, q->front, q->back, pred, user_data);
 
     q->back = q->front + q->length;
+    index_rebuild(q);
 }
 
 char queue__all(const Queue q, const filter_func_t pred, void *user_data) {
     if (!q || !pred) return FAILURE;
 
+    MIGRATE_ALL(q, q->front);
+
     return ALL(q, q->front, q->back, pred, user_data);
 }
 
 char queue__any(const Queue q, const filter_func_t pred, void *user_data) {
     if (!q || !pred) return FAILURE;
 
+    MIGRATE_ALL(q, q->front);
+
     return ANY(q, q->front, q->back, pred, user_data);
 }
 
 void queue__reverse(const Queue q) {
     if (!q || q->length < 2) return;
 
+    q->sorted_by = NULL;
+
+    if (!q->index) {
+        q->reversed = !q->reversed;
+        return;
+    }
+
+    MIGRATE_ALL(q, q->front);
+
     for (size_t i = q->front, j = q->back - 1; i < j; i++, j--) {
         SWAP(q, i, j);
     }
+    index_rebuild(q);
 }
 
 void queue__shuffle(const Queue q, const unsigned int seed) {
     if (!q) return;
 
+    MIGRATE_ALL(q, q->front);
+
+    q->reversed = false;
+    q->sorted_by = NULL;
     SHUFFLE(q, q->front, q->back, seed);
+    index_rebuild(q);
+}
+
+elem_t *queue__sample(const Queue q, const size_t k, const unsigned int seed) {
+    if (!q || !k || k > q->length) return NULL;
+
+    uint64_t state = sample__seed(seed);
+    elem_t *res = malloc(sizeof(elem_t) * k);
+    size_t *positions = malloc(sizeof(size_t) * k);
+
+    if (!res || !positions || sample__positions(q->length, k, &state, positions) < 0) {
+        free(res);
+        free(positions);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < k; i++) {
+        res[i] = q->operator_copy(SLOT(q, ORIENT(q, q->front, q->back, q->front + positions[i])));
+    }
+
+    free(positions);
+    return res;
 }
 
 void queue__sort(const Queue q, const compare_func_t cmp) {
-    if (!q || !cmp) return;
+    if (!q || !cmp || q->sorted_by == cmp) return;
+
+    MIGRATE_ALL(q, q->front);
+
+    q->reversed = false;
+    q->sorted_by = cmp;
+    sort__hybrid(q->elems + q->front, q->length, cmp);
+    index_rebuild(q);
+}
 
-    qsort(q->elems + q->front, q->length, sizeof(elem_t), cmp);
+char queue__sort_by_key(const Queue q, const key_func_t key) {
+    if (!q || !key) return FAILURE;
+
+    MIGRATE_ALL(q, q->front);
+    MATERIALIZE(q, q->front, q->back);
+
+    q->sorted_by = NULL;
+    char res = sort__by_key(q->elems + q->front, q->length, key);
+    index_rebuild(q);
+
+    return res;
+}
+
+char queue__sort_by_cached_key(const Queue q, const size_t key_size, const key_extract_func_t extract, const compare_func_t cmp) {
+    if (!q || !key_size || !extract || !cmp) return FAILURE;
+
+    MIGRATE_ALL(q, q->front);
+
+    q->reversed = false;
+    q->sorted_by = NULL;
+    char res = sort__by_cached_key(q->elems + q->front, q->length, key_size, extract, cmp);
+    index_rebuild(q);
+
+    return res;
+}
+
+size_t queue__sorted_search(const Queue q, const elem_t elem, const compare_func_t cmp) {
+    if (!q || !cmp) return SIZE_MAX;
+
+    if (q->sorted_by != cmp) {
+        MIGRATE_ALL(q, q->front);
+
+        for (size_t i = q->front; i < q->back; i++) {
+            if (!cmp(q->elems + ORIENT(q, q->front, q->back, i), &elem)) return i;
+        }
+        return SIZE_MAX;
+    }
+
+    size_t pos = LOWER_BOUND(q, q->front, q->back, elem, cmp);
+
+    return (pos < q->back && !cmp(&SLOT(q, pos), &elem)) ? pos : SIZE_MAX;
+}
+
+char queue__is_sorted(const Queue q, const compare_func_t cmp) {
+    if (!q || !cmp) return FAILURE;
+    if (q->sorted_by == cmp) return true;
+
+    MIGRATE_ALL(q, q->front);
+    MATERIALIZE(q, q->front, q->back);
+
+    if (!IS_SORTED_RANGE(q, q->front, q->back, cmp)) return false;
+
+    q->sorted_by = cmp;
+
+    return true;
 }
 
 void queue__clean_NULL(const Queue q) {
     if (!q) return;
 
+    MIGRATE_ALL(q, q->front);
+
     CLEAN_NULL_ELEMS(q, q->front, q->back);
 
     q->back = q->front + q->length;
+    index_rebuild(q);
+}
+
+char queue__compact_elements(const Queue q) {
+    if (!q || !q->copy_enabled) return FAILURE;
+
+    MIGRATE_ALL(q, q->front);
+
+    char res = COMPACT_ELEMS(q, q->front, q->back);
+    index_rebuild(q);
+
+    return res;
 }
 
 void queue__clear(const Queue q) {
     if (!q) return;
 
+    MIGRATE_ALL(q, q->front);
+
     FREE_ELEMS(q, q->front, q->back);
     RESIZE(q, DEFAULT_QUEUE_CAPACITY);
+    hash_index__clear(q->index);
+    q->reversed = false;
 
     q->front = 0;
 }
@@ -330,12 +637,115 @@ void queue__clear(const Queue q) {
 void queue__free(const Queue q) {
     if (!q) return;
 
+    MIGRATE_ALL(q, q->front);
+
     FREE_ELEMS(q, q->front, q->back);
 
+    hash_index__free(q->index);
     free(q->elems);
     free(q);
 }
 
+void queue__clear_deferred(const Queue q) {
+    if (!q) return;
+
+    MIGRATE_ALL(q, q->front);
+
+    if (!q->copy_enabled || !q->length) {
+        queue__clear(q);
+        return;
+    }
+
+    elem_t *elems = alloc__elems(DEFAULT_QUEUE_CAPACITY);
+    if (!elems) {
+        queue__clear(q);
+        return;
+    }
+
+    if (reclaimer__defer(q->elems, q->front, q->back, q->operator_delete) < 0) {
+        free(elems);
+        queue__clear(q);
+        return;
+    }
+    hash_index__clear(q->index);
+
+    q->elems = elems;
+    q->capacity = DEFAULT_QUEUE_CAPACITY;
+    q->reversed = false;
+    q->front = 0;
+    q->back = 0;
+    q->length = 0;
+}
+
+void queue__free_deferred(const Queue q) {
+    if (!q) return;
+
+    MIGRATE_ALL(q, q->front);
+
+    if (!q->copy_enabled || !q->length || reclaimer__defer(q->elems, q->front, q->back, q->operator_delete) < 0) {
+        queue__free(q);
+        return;
+    }
+
+    hash_index__free(q->index);
+    free(q);
+}
+
+char queue__enqueue_u64(const Queue q, const uint64_t value) {
+    if (!q || q->copy_enabled || !IMMEDIATE_FITS(value)) return FAILURE;
+
+    return queue__enqueue(q, IMMEDIATE_TO_ELEM(value));
+}
+
+char queue__dequeue_u64(const Queue q, uint64_t *front) {
+    elem_t elem;
+    if (!q || q->copy_enabled) return FAILURE;
+
+    if (queue__dequeue(q, &elem) < 0) return FAILURE;
+
+    if (front) {
+        *front = ELEM_TO_IMMEDIATE(elem);
+    }
+
+    return SUCCESS;
+}
+
+char queue__peek_nth_u64(const Queue q, const size_t i, uint64_t *nth) {
+    elem_t elem;
+    if (!q || q->copy_enabled || !nth) return FAILURE;
+
+    if (queue__peek_nth(q, i, &elem) < 0) return FAILURE;
+
+    *nth = ELEM_TO_IMMEDIATE(elem);
+
+    return SUCCESS;
+}
+
+size_t queue__search_u64(const Queue q, const uint64_t value) {
+    if (!q || q->copy_enabled || !IMMEDIATE_FITS(value)) return SIZE_MAX;
+
+    MIGRATE_ALL(q, q->front);
+
+    if (q->sorted_by == immediate_compare) {
+        elem_t elem = IMMEDIATE_TO_ELEM(value);
+        size_t pos = LOWER_BOUND(q, q->front, q->back, elem, immediate_compare);
+        return (pos < q->back && q->elems[pos] == elem) ? pos : SIZE_MAX;
+    }
+
+    return PTR_SEARCH(q, q->front, q->back, IMMEDIATE_TO_ELEM(value));
+}
+
+void queue__sort_u64(const Queue q) {
+    if (!q || q->copy_enabled || q->sorted_by == immediate_compare) return;
+
+    MIGRATE_ALL(q, q->front);
+
+    q->reversed = false;
+    q->sorted_by = immediate_compare;
+    IMMEDIATE_SORT(q, q->front, q->back);
+    index_rebuild(q);
+}
+
 void queue__debug(const Queue q, const debug_func_t debug) {
     setvbuf (stdout, NULL, _IONBF, 0);
 
@@ -354,7 +764,7 @@ void queue__debug(const Queue q, const debug_func_t debug) {
         printf("{ ");
         for (size_t i = 0; i < q->capacity; i++) {
             if (q->front <= i && i < q->back) {
-                debug(q->elems[i]);
+                debug(SLOT(q, ORIENT(q, q->front, q->back, i)));
             } else {
                 printf("_ ");
             }
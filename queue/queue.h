@@ -18,6 +18,29 @@
  * 2) 'queue__peek_front', 'queue__peek_back', 'queue_peek_nth' and 'queue__dequeue' return a dynamically allocated pointer to an element of
  * the queue in order to make it survive independently of the queue life cycle.
  * The user has to manually free the return pointer after usage.
+ *
+ * 3) A queue with copy disabled can store unsigned integers directly in its slots, without boxing them.
+ * The '_u64' functions handle such immediate values, they fail on a queue with copy enabled.
+ * Values are stored tagged so that 0 is not taken for a removed element, they must fit in a pointer
+ * minus one bit (63 bits on 64-bit hosts).
+ *
+ * 4) In incremental resize mode, a resize allocates the new buffer without copying the elements, which are then
+ * migrated a few at a time by the following operations. Every O(1) operation then has an O(1) worst-case cost,
+ * the O(n) operations complete the pending migration first.
+ *
+ * 5) A queue can maintain a hash index of its elements, set with 'queue__set_index'. 'queue__search' and
+ * 'queue__contains' called with the match function of the index then run in O(1) expected time. The index
+ * is updated by every operation, those reordering the elements rebuild it in O(n). NULL elements are not indexed.
+ *
+ * 6) 'queue__reverse' only flips the logical direction of the queue, which peek, swap, remove, enqueue, dequeue, search
+ * and foreach functions honor. A reversed queue enqueues before its front, the elements are moved to the middle of
+ * the buffer when no slot is left there, with room proportional to their number. The elements are only physically
+ * reversed by the O(n) operations depending on the order of the buffer, such as 'queue__to_array'.
+ *
+ * 7) A queue remembers the compare function it was last sorted with. Sorting it again with the same function
+ * is then O(1) and 'queue__sorted_search' uses a binary search. The state is kept by the operations preserving
+ * the order (dequeue, filter, enqueue of an element not less than the last one) and dropped by the others.
+ * Modifying the pointed values of sorted elements behind the queue's back is not detected.
  */
 typedef struct QueueSt * Queue;
 
@@ -67,6 +90,30 @@ char queue__is_empty(const Queue q);
 size_t queue__length(const Queue q);
 
 
+/**
+ * @brief enables or disables the incremental resize mode of the queue
+ * @details disabling the mode completes the pending migration
+ * @note complexity: O(1), O(n) when disabling during a migration
+ * @param q the queue
+ * @param enabled true to enable the mode
+ * @return 0 on success, -1 on failure
+ */
+char queue__set_incremental_resize(const Queue q, const char enabled);
+
+
+/**
+ * @brief sets or removes the hash index of the queue
+ * @details the index is built from the current elements. The hash function receives the elements as stored
+ * in the queue, equal elements according to 'match' must have the same hash. A NULL hash removes the index
+ * @note complexity: O(n)
+ * @param q the queue
+ * @param hash the hash function, NULL to remove the index
+ * @param match the match function of the index
+ * @return 0 on success, -1 on failure
+ */
+char queue__set_index(const Queue q, const key_func_t hash, const compare_func_t match);
+
+
 /**
  * @brief adds an element in the queue
  * @note complexity: O(1)
@@ -200,7 +247,7 @@ size_t queue__ptr_search(const Queue q, const elem_t elem);
 
 /**
  * @brief search the given element
- * @note complexity: O(n)
+ * @note complexity: O(n), O(1) expected with the match function of the index
  * @param q the queue
  * @param elem the element to search
  * @param match the matching function
@@ -221,7 +268,7 @@ char queue__ptr_contains(const Queue q, const elem_t elem);
 
 /**
  * @brief checks if a given element is on the queue
- * @note complexity: O(n)
+ * @note complexity: O(n), O(1) expected with the match function of the index
  * @param q the queue
  * @param elem the element
  * @param match the matching function
@@ -285,7 +332,8 @@ void queue__filter(const Queue q, const filter_func_t pred, void *user_data);
 
 /**
  * @brief reverse the queue
- * @note complexity: O(n)
+ * @details the reversal is logical, except on a queue with an index which is physically reversed
+ * @note complexity: O(1), O(n) on a queue with an index
  * @param q the queue
  */
 void queue__reverse(const Queue q);
@@ -300,14 +348,77 @@ void queue__shuffle(const Queue q, const unsigned int seed);
 
 
 /**
- * @brief uses qsort to sort the queue elements using the given compare function
- * @note complexity: O(n*log(n))
+ * @brief retrieves copies of k elements of the queue drawn uniformly without replacement, in random order
+ * @details the array must be manually freed by user afterward. The queue is left unchanged
+ * @note complexity: O(k), independent of the length of the queue
+ * @param q the queue
+ * @param k number of elements to draw, not greater than the length of the queue
+ * @param seed the seed of the random generator
+ * @return a pointer to dynamically allocated array of k elements on success, NULL on failure
+ */
+elem_t *queue__sample(const Queue q, const size_t k, const unsigned int seed);
+
+
+/**
+ * @brief sorts the queue elements using the given compare function
+ * @details already sorted and reverse sorted queues are detected in linear time, small queues are insertion sorted
+ * and larger ones use a pattern-defeating quicksort. As with qsort, the sort is not stable
+ * @note complexity: O(n*log(n)), O(1) if the queue is known to be sorted with 'cmp'
  * @param q the queue
  * @param cmp the compare function
  */
 void queue__sort(const Queue q, const compare_func_t cmp);
 
 
+/**
+ * @brief sorts the queue elements by an integer key computed once per element
+ * @details the keys are cached next to their elements and sorted with a stable radix sort,
+ * elements with equal keys keep their relative order
+ * @note complexity: O(n)
+ * @param q the queue
+ * @param key the key function, called exactly once per element
+ * @return 0 on success, -1 on failure
+ */
+char queue__sort_by_key(const Queue q, const key_func_t key);
+
+
+/**
+ * @brief sorts the queue elements by a key extracted once per element
+ * @details the keys are cached next to their elements in a side array sorted with qsort, so that 'cmp'
+ * compares the cached keys and never dereferences the elements. 'cmp' receives pointers to keys
+ * @note complexity: O(n*log(n))
+ * @param q the queue
+ * @param key_size byte size of a key
+ * @param extract the extraction function, called exactly once per element
+ * @param cmp the compare function
+ * @return 0 on success, -1 on failure
+ */
+char queue__sort_by_cached_key(const Queue q, const size_t key_size, const key_extract_func_t extract, const compare_func_t cmp);
+
+
+/**
+ * @brief search an element with the compare function
+ * @details the search is binary if the queue is known to be sorted with 'cmp', linear otherwise
+ * @note complexity: O(log(n)) if the queue is known to be sorted with 'cmp', O(n) otherwise
+ * @param q the queue
+ * @param elem the element to search
+ * @param cmp the compare function, receives pointers to elements as with qsort
+ * @return the position of the first element comparing equal to 'elem' if there is one, SIZE_MAX if not, SIZE_MAX on failure
+ */
+size_t queue__sorted_search(const Queue q, const elem_t elem, const compare_func_t cmp);
+
+
+/**
+ * @brief checks if the queue is sorted with the compare function
+ * @details a queue found sorted is then known to be sorted with 'cmp'
+ * @note complexity: O(1) if the queue is known to be sorted with 'cmp', O(n) otherwise
+ * @param q the queue
+ * @param cmp the compare function
+ * @return 1 if the queue is sorted, 0 if not, -1 on failure
+ */
+char queue__is_sorted(const Queue q, const compare_func_t cmp);
+
+
 /**
  * @brief removes all NULL pointers in the queue
  * @note complexity: O(n)
@@ -316,6 +427,18 @@ void queue__sort(const Queue q, const compare_func_t cmp);
 void queue__clean_NULL(const Queue q);
 
 
+/**
+ * @brief re-copies all elements of the queue in container order
+ * @details every element is copied with the copy operator before the old ones are deleted, the placement of
+ * the copies is left to the allocator. Pointers to the old elements, e.g. kept from 'queue__foreach',
+ * are invalidated. On failure the queue is left unaltered
+ * @note complexity: O(n)
+ * @param q the queue, with copy enabled
+ * @return 0 on success, -1 on failure
+ */
+char queue__compact_elements(const Queue q);
+
+
 /**
  * @brief removes all elements in the queue
  * @details if copy is enabled frees all allocated memory used by these elements, the queue is still usable afterwards
@@ -334,6 +457,75 @@ void queue__clear(const Queue q);
 void queue__free(const Queue q);
 
 
+/**
+ * @brief removes all elements in the queue, handing their destruction to the background reclaimer
+ * @details if copy is enabled the detached elements are deleted on the reclaimer thread, the delete operator must
+ * therefore be thread-safe. Falls back to 'queue__clear' if the reclaimer is unavailable
+ * @note complexity: O(1), plus O(m) in incremental resize mode where m is the number of elements not yet migrated
+ * @param q the queue
+ */
+void queue__clear_deferred(const Queue q);
+
+
+/**
+ * @brief frees all allocated memory used by the queue, handing the destruction of its elements to the background reclaimer
+ * @details if copy is enabled the elements are deleted on the reclaimer thread, the delete operator must
+ * therefore be thread-safe. Falls back to 'queue__free' if the reclaimer is unavailable
+ * @note complexity: O(1), plus O(m) in incremental resize mode where m is the number of elements not yet migrated
+ * @param q the queue
+ */
+void queue__free_deferred(const Queue q);
+
+
+/**
+ * @brief adds an immediate value in the queue
+ * @note complexity: O(1)
+ * @param q the queue, with copy disabled
+ * @param value the value to add, which must fit in a pointer minus one bit
+ * @return 0 on success, -1 on failure
+ */
+char queue__enqueue_u64(const Queue q, const uint64_t value);
+
+
+/**
+ * @brief removes the front immediate value of the queue
+ * @note complexity: O(1)
+ * @param q the queue, with copy disabled
+ * @param front pointer to storage variable, can be NULL
+ * @return 0 on success, -1 on failure
+ */
+char queue__dequeue_u64(const Queue q, uint64_t *front);
+
+
+/**
+ * @brief retrieve the immediate value at 'i' position of the queue without removing it
+ * @note complexity: O(1)
+ * @param q the queue, with copy disabled
+ * @param i position
+ * @param nth pointer to storage variable
+ * @return 0 on success, -1 on failure
+ */
+char queue__peek_nth_u64(const Queue q, const size_t i, uint64_t *nth);
+
+
+/**
+ * @brief search the given immediate value
+ * @note complexity: O(n), O(log(n)) once sorted with 'queue__sort_u64'
+ * @param q the queue, with copy disabled
+ * @param value the value to search
+ * @return the position of the value in the queue if it is contained in it, SIZE_MAX if not, SIZE_MAX on failure
+ */
+size_t queue__search_u64(const Queue q, const uint64_t value);
+
+
+/**
+ * @brief sorts the immediate values of the queue in ascending order
+ * @note complexity: O(n*log(n))
+ * @param q the queue, with copy disabled
+ */
+void queue__sort_u64(const Queue q);
+
+
 /**
  * @brief prints the queue's content
  * @note complexity: O(n)
@@ -0,0 +1,240 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "reservoir.h"
+#include "../common/sample.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///     RESERVOIR STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A sampled element, the key is only used by weighted reservoirs
+ */
+typedef struct
+{
+    double key;
+    elem_t elem;
+} Candidate;
+
+struct ReservoirSt
+{
+    Candidate *candidates;
+    size_t k;
+    size_t length;
+    size_t seen;
+    size_t next;
+    double w;
+    double weight_to_skip;
+    char weighted;
+    uint64_t state;
+    delete_operator_t operator_delete;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     RESERVOIR UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+static inline void drop(const Reservoir r, const elem_t elem) {
+    if (r->operator_delete) r->operator_delete(elem);
+}
+
+/**
+ * Draws the number of elements rejected before the next one enters a full uniform sample (Algorithm L)
+ */
+static void draw_next(const Reservoir r) {
+    double gap = floor(log(sample__unit(&r->state)) / log(1.0 - r->w));
+
+    r->next = gap < (double)(SIZE_MAX - r->seen) ? r->seen + (size_t)gap : SIZE_MAX;
+    r->w *= exp(log(sample__unit(&r->state)) / (double)r->k);
+}
+
+/**
+ * Sifts down the candidate at root in the min-heap of keys of a weighted reservoir
+ */
+static void sift_down(const Reservoir r, size_t root) {
+    Candidate tmp;
+    size_t child;
+
+    while ((child = 2 * root + 1) < r->length) {
+        if (child + 1 < r->length && r->candidates[child + 1].key < r->candidates[child].key) child++;
+        if (r->candidates[root].key <= r->candidates[child].key) return;
+        tmp = r->candidates[root];
+        r->candidates[root] = r->candidates[child];
+        r->candidates[child] = tmp;
+        root = child;
+    }
+}
+
+static void sift_up(const Reservoir r, size_t i) {
+    Candidate tmp;
+
+    while (i && r->candidates[i].key < r->candidates[(i - 1) / 2].key) {
+        tmp = r->candidates[i];
+        r->candidates[i] = r->candidates[(i - 1) / 2];
+        r->candidates[(i - 1) / 2] = tmp;
+        i = (i - 1) / 2;
+    }
+}
+
+/**
+ * Draws the total weight of the elements jumped over before the next one enters a full weighted sample (Algorithm A-ExpJ),
+ * the smallest key is the logarithm of the threshold
+ */
+static inline void draw_weight_to_skip(const Reservoir r) {
+    r->weight_to_skip = log(sample__unit(&r->state)) / r->candidates[0].key;
+}
+
+static Reservoir reservoir_init(const size_t k, const unsigned int seed, const char weighted, const delete_operator_t delete_op) {
+    if (!k || k > SIZE_MAX / sizeof(Candidate)) return NULL;
+
+    Reservoir r = malloc(sizeof(struct ReservoirSt));
+    if (!r) return NULL;
+
+    r->candidates = malloc(sizeof(Candidate) * k);
+    if (!r->candidates) {
+        free(r);
+        return NULL;
+    }
+
+    r->k = k;
+    r->length = 0;
+    r->seen = 0;
+    r->next = 0;
+    r->w = 0;
+    r->weight_to_skip = 0;
+    r->weighted = weighted;
+    r->state = sample__seed(seed);
+    r->operator_delete = delete_op;
+
+    return r;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     RESERVOIR FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+Reservoir reservoir__empty(const size_t k, const unsigned int seed, const delete_operator_t delete_op) {
+    return reservoir_init(k, seed, false, delete_op);
+}
+
+Reservoir reservoir__empty_weighted(const size_t k, const unsigned int seed, const delete_operator_t delete_op) {
+    return reservoir_init(k, seed, true, delete_op);
+}
+
+inline size_t reservoir__length(const Reservoir r) {
+    return r ? r->length : SIZE_MAX;
+}
+
+inline size_t reservoir__seen(const Reservoir r) {
+    return r ? r->seen : SIZE_MAX;
+}
+
+char reservoir__push(const Reservoir r, const elem_t element) {
+    if (!r || r->weighted || r->seen == SIZE_MAX) return FAILURE;
+
+    if (r->length < r->k) {
+        r->candidates[r->length++].elem = element;
+        r->seen++;
+        if (r->length == r->k) {
+            r->w = exp(log(sample__unit(&r->state)) / (double)r->k);
+            draw_next(r);
+        }
+        return SUCCESS;
+    }
+
+    if (r->seen < r->next) {
+        drop(r, element);
+        r->seen++;
+        return SUCCESS;
+    }
+
+    size_t i = sample__below(&r->state, r->k);
+    drop(r, r->candidates[i].elem);
+    r->candidates[i].elem = element;
+    r->seen++;
+    draw_next(r);
+
+    return SUCCESS;
+}
+
+char reservoir__push_weighted(const Reservoir r, const elem_t element, const double weight) {
+    if (!r || !r->weighted || !(weight > 0) || r->seen == SIZE_MAX) return FAILURE;
+
+    r->seen++;
+
+    if (r->length < r->k) {
+        r->candidates[r->length].key = log(sample__unit(&r->state)) / weight;
+        r->candidates[r->length].elem = element;
+        sift_up(r, r->length++);
+        if (r->length == r->k) draw_weight_to_skip(r);
+        return SUCCESS;
+    }
+
+    if (weight < r->weight_to_skip) {
+        r->weight_to_skip -= weight;
+        drop(r, element);
+        return SUCCESS;
+    }
+
+    /* the new key is drawn above the threshold, in log space: u in (threshold^weight, 1) */
+    double low = exp(weight * r->candidates[0].key);
+    double u = low + (1.0 - low) * sample__unit(&r->state);
+
+    drop(r, r->candidates[0].elem);
+    r->candidates[0].key = log(u) / weight;
+    r->candidates[0].elem = element;
+    sift_down(r, 0);
+    draw_weight_to_skip(r);
+
+    return SUCCESS;
+}
+
+size_t reservoir__to_skip(const Reservoir r) {
+    if (!r || r->weighted) return SIZE_MAX;
+
+    return r->length < r->k ? 0 : r->next - r->seen;
+}
+
+char reservoir__skip(const Reservoir r, const size_t n) {
+    if (!r || r->weighted || n > reservoir__to_skip(r)) return FAILURE;
+
+    r->seen += n;
+
+    return SUCCESS;
+}
+
+elem_t *reservoir__dump(const Reservoir r) {
+    if (!r || !r->length) return NULL;
+
+    elem_t *res = malloc(sizeof(elem_t) * r->length);
+    if (!res) return NULL;
+
+    for (size_t i = 0; i < r->length; i++) {
+        res[i] = r->candidates[i].elem;
+    }
+    r->length = 0;
+    r->seen = 0;
+
+    return res;
+}
+
+void reservoir__clear(const Reservoir r) {
+    if (!r) return;
+
+    for (size_t i = 0; i < r->length; i++) {
+        drop(r, r->candidates[i].elem);
+    }
+    r->length = 0;
+    r->seen = 0;
+}
+
+void reservoir__free(const Reservoir r) {
+    if (!r) return;
+
+    reservoir__clear(r);
+    free(r->candidates);
+    free(r);
+}
@@ -0,0 +1,133 @@
+#ifndef __RESERVOIR_H__
+#define __RESERVOIR_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a reservoir keeping a random sample of k elements of a stream of unknown length
+ *
+ * Notes :
+ * 1) A uniform reservoir uses Algorithm L: once full, it draws how many elements of the stream to skip
+ * before the next one enters the sample, so only O(k*log(n/k)) random values are drawn for n elements.
+ * 'reservoir__to_skip' gives that number, a stream able to seek can pass over them with 'reservoir__skip'.
+ *
+ * 2) A weighted reservoir uses Algorithm A-ExpJ: element i enters the sample as if drawn with probability
+ * proportional to its weight, the weights to jump over are drawn the same way. Keys are kept as logarithms
+ * to handle weights and streams of any size.
+ *
+ * 3) The reservoir owns the pushed elements, the rejected and evicted ones are deleted with its delete operator,
+ * if any. 'reservoir__dump' gives back the ownership of the sampled elements.
+ */
+typedef struct ReservoirSt * Reservoir;
+
+
+/**
+ * @brief create an empty uniform reservoir
+ * @note complexity: O(k)
+ * @param k size of the sample, not 0
+ * @param seed the seed of the random generator
+ * @param delete_op the delete operator, NULL if the elements are not owned
+ * @return a pointer to the reservoir on success, NULL on failure
+ */
+Reservoir reservoir__empty(const size_t k, const unsigned int seed, const delete_operator_t delete_op);
+
+
+/**
+ * @brief create an empty weighted reservoir
+ * @note complexity: O(k)
+ * @param k size of the sample, not 0
+ * @param seed the seed of the random generator
+ * @param delete_op the delete operator, NULL if the elements are not owned
+ * @return a pointer to the reservoir on success, NULL on failure
+ */
+Reservoir reservoir__empty_weighted(const size_t k, const unsigned int seed, const delete_operator_t delete_op);
+
+
+/**
+ * @brief number of elements in the sample
+ * @note complexity: O(1)
+ * @param r the reservoir
+ * @return the number of elements on success, SIZE_MAX on failure
+ */
+size_t reservoir__length(const Reservoir r);
+
+
+/**
+ * @brief number of elements of the stream seen by the reservoir, skipped ones included
+ * @note complexity: O(1)
+ * @param r the reservoir
+ * @return the number of elements on success, SIZE_MAX on failure
+ */
+size_t reservoir__seen(const Reservoir r);
+
+
+/**
+ * @brief pushes the next element of the stream in a uniform reservoir
+ * @note complexity: O(1)
+ * @param r the reservoir
+ * @param element the element
+ * @return 0 on success, -1 on failure
+ */
+char reservoir__push(const Reservoir r, const elem_t element);
+
+
+/**
+ * @brief pushes the next element of the stream in a weighted reservoir
+ * @note complexity: O(1) if the element is skipped, O(log(k)) if it enters the sample
+ * @param r the reservoir
+ * @param element the element
+ * @param weight the weight of the element, greater than 0
+ * @return 0 on success, -1 on failure
+ */
+char reservoir__push_weighted(const Reservoir r, const elem_t element, const double weight);
+
+
+/**
+ * @brief number of next elements of the stream that a uniform reservoir will reject
+ * @note complexity: O(1)
+ * @param r the reservoir
+ * @return the number of elements on success, SIZE_MAX on failure
+ */
+size_t reservoir__to_skip(const Reservoir r);
+
+
+/**
+ * @brief passes over elements of the stream without pushing them in a uniform reservoir
+ * @note complexity: O(1)
+ * @param r the reservoir
+ * @param n number of elements, not greater than 'reservoir__to_skip'
+ * @return 0 on success, -1 on failure
+ */
+char reservoir__skip(const Reservoir r, const size_t n);
+
+
+/**
+ * @brief dump the sampled elements into an array
+ * @details the array must be manually freed by user afterward, the reservoir is reset to sample a new stream
+ * @note complexity: O(k)
+ * @param r the reservoir
+ * @return a pointer to dynamically allocated array on success, NULL on failure
+ */
+elem_t *reservoir__dump(const Reservoir r);
+
+
+/**
+ * @brief deletes the sampled elements and resets the reservoir to sample a new stream
+ * @note complexity: O(k)
+ * @param r the reservoir
+ */
+void reservoir__clear(const Reservoir r);
+
+
+/**
+ * @brief frees all allocated memory used by the reservoir and deletes the sampled elements
+ * @note complexity: O(k)
+ * @param r the reservoir
+ */
+void reservoir__free(const Reservoir r);
+
+
+#endif
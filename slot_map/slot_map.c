@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "slot_map.h"
+
+#define DEFAULT_SLOT_MAP_CAPACITY 4
+
+/**
+ * End of the free list, slot indices are stored on 32 bits
+ */
+#define NO_SLOT UINT32_MAX
+
+///////////////////////////////////////////////////////////////////////////////
+///     SLOT MAP STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A slot holds the position of its element in the dense array, or the next free slot.
+ * Its generation is odd while it holds an element
+ */
+typedef struct
+{
+    uint32_t generation;
+    uint32_t position;
+} Slot;
+
+struct SlotMapSt
+{
+    elem_t *elems;
+    uint32_t *owners;
+    size_t length;
+    size_t capacity;
+    Slot *slots;
+    size_t n_slots;
+    size_t slots_capacity;
+    uint32_t free_head;
+    char copy_enabled;
+    copy_operator_t operator_copy;
+    delete_operator_t operator_delete;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     SLOT MAP MACRO UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+static inline elem_t id(elem_t e) {
+    return e;
+}
+
+static inline void skip(elem_t e) {
+    return;
+}
+
+#define HANDLE(__index, __generation) \
+    (((slot_handle_t)(__generation) << 32) | (slot_handle_t)(__index))
+
+#define HANDLE_INDEX(__handle) \
+    ((size_t)((__handle) & UINT32_MAX))
+
+#define HANDLE_GENERATION(__handle) \
+    ((uint32_t)((__handle) >> 32))
+
+/**
+ * Macro to check if the handle refers to an element, the generation of a slot holding one is odd
+ */
+#define IS_LIVE(__ptr, __handle) \
+    (HANDLE_INDEX(__handle) < (__ptr)->n_slots \
+     && (__ptr)->slots[HANDLE_INDEX(__handle)].generation == HANDLE_GENERATION(__handle) \
+     && (HANDLE_GENERATION(__handle) & 1))
+
+///////////////////////////////////////////////////////////////////////////////
+///     SLOT MAP UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+static SlotMap slot_map_init(const copy_operator_t copy_op, const delete_operator_t delete_op) {
+    SlotMap m = malloc(sizeof(struct SlotMapSt));
+    if (!m) return NULL;
+
+    m->elems = malloc(sizeof(elem_t) * DEFAULT_SLOT_MAP_CAPACITY);
+    m->owners = malloc(sizeof(uint32_t) * DEFAULT_SLOT_MAP_CAPACITY);
+    m->slots = malloc(sizeof(Slot) * DEFAULT_SLOT_MAP_CAPACITY);
+    if (!m->elems || !m->owners || !m->slots) {
+        free(m->elems);
+        free(m->owners);
+        free(m->slots);
+        free(m);
+        return NULL;
+    }
+
+    m->length = 0;
+    m->capacity = DEFAULT_SLOT_MAP_CAPACITY;
+    m->n_slots = 0;
+    m->slots_capacity = DEFAULT_SLOT_MAP_CAPACITY;
+    m->free_head = NO_SLOT;
+    m->copy_enabled = copy_op ? true : false;
+    m->operator_copy = copy_op ? copy_op : id;
+    m->operator_delete = delete_op ? delete_op : skip;
+
+    return m;
+}
+
+/**
+ * Grows the dense arrays so that they hold one more element
+ */
+static char reserve_elems(const SlotMap m) {
+    if (m->length < m->capacity) return SUCCESS;
+
+    size_t capacity = m->capacity<<1;
+    elem_t *elems = realloc(m->elems, sizeof(elem_t) * capacity);
+    if (!elems) return FAILURE;
+    m->elems = elems;
+
+    uint32_t *owners = realloc(m->owners, sizeof(uint32_t) * capacity);
+    if (!owners) return FAILURE;
+    m->owners = owners;
+
+    m->capacity = capacity;
+
+    return SUCCESS;
+}
+
+/**
+ * Takes a free slot, or appends a new one when the free list is empty, returns NO_SLOT on failure
+ */
+static uint32_t take_slot(const SlotMap m) {
+    uint32_t index = m->free_head;
+
+    if (index != NO_SLOT) {
+        m->free_head = m->slots[index].position;
+        return index;
+    }
+
+    if (m->n_slots >= NO_SLOT) return NO_SLOT;
+
+    if (m->n_slots == m->slots_capacity) {
+        Slot *slots = realloc(m->slots, sizeof(Slot) * (m->slots_capacity<<1));
+        if (!slots) return NO_SLOT;
+        m->slots = slots;
+        m->slots_capacity <<= 1;
+    }
+
+    m->slots[m->n_slots].generation = 0;
+
+    return (uint32_t)m->n_slots++;
+}
+
+/**
+ * Frees the slot, which makes its handles stale, and puts it on the free list
+ */
+static inline void release_slot(const SlotMap m, const uint32_t index) {
+    m->slots[index].generation++;
+    m->slots[index].position = m->free_head;
+    m->free_head = index;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     SLOT MAP FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+SlotMap slot_map__empty_copy_disabled(void) {
+    return slot_map_init(NULL, NULL);
+}
+
+SlotMap slot_map__empty_copy_enabled(const copy_operator_t copy_op, const delete_operator_t delete_op) {
+    if (!copy_op || !delete_op) return NULL;
+
+    return slot_map_init(copy_op, delete_op);
+}
+
+inline char slot_map__is_empty(const SlotMap m) {
+    return !m ? FAILURE : !m->length;
+}
+
+inline size_t slot_map__length(const SlotMap m) {
+    return !m ? SIZE_MAX : m->length;
+}
+
+char slot_map__insert(const SlotMap m, const elem_t element, slot_handle_t *handle) {
+    if (!m || !handle) return FAILURE;
+
+    if (reserve_elems(m) < 0) return FAILURE;
+
+    uint32_t index = take_slot(m);
+    if (index == NO_SLOT) return FAILURE;
+
+    Slot *slot = m->slots + index;
+    slot->generation++;
+    slot->position = (uint32_t)m->length;
+
+    m->elems[m->length] = m->operator_copy(element);
+    m->owners[m->length] = index;
+    m->length++;
+
+    *handle = HANDLE(index, slot->generation);
+
+    return SUCCESS;
+}
+
+char slot_map__contains(const SlotMap m, const slot_handle_t handle) {
+    if (!m) return FAILURE;
+
+    return IS_LIVE(m, handle) ? true : false;
+}
+
+char slot_map__get(const SlotMap m, const slot_handle_t handle, elem_t *elem) {
+    if (!m || !elem) return FAILURE;
+
+    if (!IS_LIVE(m, handle)) return FAILURE;
+
+    *elem = m->operator_copy(m->elems[m->slots[HANDLE_INDEX(handle)].position]);
+
+    return SUCCESS;
+}
+
+char slot_map__remove(const SlotMap m, const slot_handle_t handle, elem_t *elem) {
+    if (!m) return FAILURE;
+
+    if (!IS_LIVE(m, handle)) return FAILURE;
+
+    size_t position = m->slots[HANDLE_INDEX(handle)].position;
+
+    if (elem) {
+        *elem = m->elems[position];
+    } else {
+        m->operator_delete(m->elems[position]);
+    }
+
+    /* the last element fills the hole to keep the storage dense */
+    m->length--;
+    m->elems[position] = m->elems[m->length];
+    m->owners[position] = m->owners[m->length];
+    m->slots[m->owners[position]].position = (uint32_t)position;
+
+    release_slot(m, (uint32_t)HANDLE_INDEX(handle));
+
+    return SUCCESS;
+}
+
+void slot_map__foreach(const SlotMap m, const applying_func_t func, void *user_data) {
+    if (!m || !func) return;
+
+    for (size_t i = 0; i < m->length; i++) {
+        func(m->elems[i], user_data);
+    }
+}
+
+void slot_map__clear(const SlotMap m) {
+    if (!m) return;
+
+    for (size_t i = 0; i < m->length; i++) {
+        if (m->copy_enabled) m->operator_delete(m->elems[i]);
+        release_slot(m, m->owners[i]);
+    }
+    m->length = 0;
+}
+
+void slot_map__free(const SlotMap m) {
+    if (!m) return;
+
+    if (m->copy_enabled) {
+        for (size_t i = 0; i < m->length; i++) {
+            m->operator_delete(m->elems[i]);
+        }
+    }
+
+    free(m->elems);
+    free(m->owners);
+    free(m->slots);
+    free(m);
+}
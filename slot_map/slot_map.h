@@ -0,0 +1,146 @@
+#ifndef __SLOT_MAP_H__
+#define __SLOT_MAP_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a slot map, storing elements densely and referring to them by stable handles
+ *
+ * Notes :
+ * 1) You have to correctly implement copy and delete operators
+ * by handling NULL value, otherwise you can end up with an undefined behaviour.
+ * The prototypes of these functions are:
+ * elem_t (*copy_op)(elem_t)
+ * void (*delete_op)(elem_t)
+ *
+ * 2) The elements are kept in a contiguous array, iterating over them does not skip holes. Removing an element
+ * moves the last one into its place, so the iteration order is not the insertion order.
+ *
+ * 3) A handle holds the index of a slot and its generation. The generation of a slot is incremented when its element
+ * is removed, handles to removed elements are therefore rejected even after the slot is reused by another element.
+ * Free slots are reused from a free list. The generation is 32 bits wide, a slot reused 2^31 times would accept
+ * again the handles of its first element.
+ *
+ * 4) 'slot_map__get' returns a copy of the element, 'slot_map__remove' returns the element itself.
+ * The user has to manually free them after usage.
+ */
+typedef struct SlotMapSt * SlotMap;
+
+/**
+ * Stable reference to an element of a slot map, 0 is never a valid handle
+ */
+typedef uint64_t slot_handle_t;
+
+
+/**
+ * @brief create an empty slot map with copy disabled
+ * @note complexity: O(1)
+ * @return a pointer to the slot map on success, NULL on failure
+ */
+SlotMap slot_map__empty_copy_disabled(void);
+
+
+/**
+ * @brief create an empty slot map with copy enabled
+ * @note complexity: O(1)
+ * @param copy_op copy operator
+ * @param delete_op delete operator
+ * @return a pointer to the slot map on success, NULL on failure
+ */
+SlotMap slot_map__empty_copy_enabled(const copy_operator_t copy_op, const delete_operator_t delete_op);
+
+
+/**
+ * @brief checks if the slot map is empty
+ * @note complexity: O(1)
+ * @param m the slot map
+ * @return 1 if the slot map is empty, 0 if not, -1 on failure
+ */
+char slot_map__is_empty(const SlotMap m);
+
+
+/**
+ * @brief number of elements in the slot map
+ * @note complexity: O(1)
+ * @param m the slot map
+ * @return the number of elements on success, SIZE_MAX on failure
+ */
+size_t slot_map__length(const SlotMap m);
+
+
+/**
+ * @brief inserts an element in the slot map
+ * @note complexity: O(1) amortized
+ * @param m the slot map
+ * @param element the element
+ * @param handle pointer to storage variable for the handle of the element
+ * @return 0 on success, -1 on failure
+ */
+char slot_map__insert(const SlotMap m, const elem_t element, slot_handle_t *handle);
+
+
+/**
+ * @brief checks if the handle refers to an element of the slot map
+ * @note complexity: O(1)
+ * @param m the slot map
+ * @param handle the handle
+ * @return 1 if the element is in the slot map, 0 if not, -1 on failure
+ */
+char slot_map__contains(const SlotMap m, const slot_handle_t handle);
+
+
+/**
+ * @brief retrieve a copy of the element referred to by the handle
+ * @details the element is stored in 'elem' variable and must be manually freed by user afterward
+ * @note complexity: O(1)
+ * @param m the slot map
+ * @param handle the handle
+ * @param elem pointer to storage variable
+ * @return 0 on success, -1 if the handle is stale or on failure
+ */
+char slot_map__get(const SlotMap m, const slot_handle_t handle, elem_t *elem);
+
+
+/**
+ * @brief removes the element referred to by the handle
+ * @details the element is stored in 'elem' variable and must be manually freed by user afterward,
+ * it is deleted if 'elem' is NULL
+ * @note complexity: O(1)
+ * @param m the slot map
+ * @param handle the handle
+ * @param elem pointer to storage variable, can be NULL
+ * @return 0 on success, -1 if the handle is stale or on failure
+ */
+char slot_map__remove(const SlotMap m, const slot_handle_t handle, elem_t *elem);
+
+
+/**
+ * @brief applies the function on every element, in storage order
+ * @note complexity: O(n)
+ * @param m the slot map
+ * @param func the function
+ * @param user_data the user data given to the function
+ */
+void slot_map__foreach(const SlotMap m, const applying_func_t func, void *user_data);
+
+
+/**
+ * @brief removes all elements of the slot map, all handles become stale
+ * @note complexity: O(n)
+ * @param m the slot map
+ */
+void slot_map__clear(const SlotMap m);
+
+
+/**
+ * @brief frees all allocated memory used by the slot map
+ * @note complexity: O(n)
+ * @param m the slot map
+ */
+void slot_map__free(const SlotMap m);
+
+
+#endif
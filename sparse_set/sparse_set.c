@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sparse_set.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///     SPARSE SET STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+struct SparseSetSt
+{
+    size_t *dense;
+    size_t *sparse;
+    size_t length;
+    size_t universe;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     SPARSE SET MACRO UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Macro to check if the id is in the set, whatever the stale value of its sparse entry
+ */
+#define HAS_ID(__ptr, __id) \
+    ((__id) < (__ptr)->universe && (__ptr)->sparse[__id] < (__ptr)->length && (__ptr)->dense[(__ptr)->sparse[__id]] == (__id))
+
+///////////////////////////////////////////////////////////////////////////////
+///     SPARSE SET FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+SparseSet sparse_set__empty(const size_t universe) {
+    if (!universe || universe > SIZE_MAX / sizeof(size_t)) return NULL;
+
+    SparseSet s = malloc(sizeof(struct SparseSetSt));
+    if (!s) return NULL;
+
+    /* the sparse array is zeroed to keep memory checkers quiet, its entries are never trusted */
+    s->dense = malloc(sizeof(size_t) * universe);
+    s->sparse = calloc(universe, sizeof(size_t));
+    if (!s->dense || !s->sparse) {
+        free(s->dense);
+        free(s->sparse);
+        free(s);
+        return NULL;
+    }
+
+    s->length = 0;
+    s->universe = universe;
+
+    return s;
+}
+
+inline char sparse_set__is_empty(const SparseSet s) {
+    return !s ? FAILURE : !s->length;
+}
+
+inline size_t sparse_set__length(const SparseSet s) {
+    return !s ? SIZE_MAX : s->length;
+}
+
+inline size_t sparse_set__universe(const SparseSet s) {
+    return !s ? SIZE_MAX : s->universe;
+}
+
+char sparse_set__insert(const SparseSet s, const size_t id) {
+    if (!s || id >= s->universe) return FAILURE;
+
+    if (HAS_ID(s, id)) return SUCCESS;
+
+    s->dense[s->length] = id;
+    s->sparse[id] = s->length;
+    s->length++;
+
+    return SUCCESS;
+}
+
+char sparse_set__remove(const SparseSet s, const size_t id) {
+    if (!s || !HAS_ID(s, id)) return FAILURE;
+
+    size_t position = s->sparse[id];
+    size_t last = s->dense[--s->length];
+
+    s->dense[position] = last;
+    s->sparse[last] = position;
+
+    return SUCCESS;
+}
+
+char sparse_set__contains(const SparseSet s, const size_t id) {
+    if (!s) return FAILURE;
+
+    return HAS_ID(s, id) ? true : false;
+}
+
+const size_t *sparse_set__ids(const SparseSet s) {
+    return !s ? NULL : s->dense;
+}
+
+void sparse_set__clear(const SparseSet s) {
+    if (!s) return;
+
+    s->length = 0;
+}
+
+void sparse_set__free(const SparseSet s) {
+    if (!s) return;
+
+    free(s->dense);
+    free(s->sparse);
+    free(s);
+}
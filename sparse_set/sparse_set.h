@@ -0,0 +1,118 @@
+#ifndef __SPARSE_SET_H__
+#define __SPARSE_SET_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a sparse set of integer ids taken in [0, universe)
+ *
+ * Notes :
+ * 1) The ids of the set are stored contiguously in a dense array, and a sparse array of the size of the universe
+ * gives the position of every id in the dense array. An id belongs to the set when the dense array holds it at
+ * the position given by the sparse array, stale entries of the sparse array are therefore harmless.
+ *
+ * 2) Insert, remove, contains and clear are O(1): clearing only resets the length. Removing an id moves the last one
+ * into its place, so the iteration order is not the insertion order.
+ *
+ * 3) The set allocates O(universe) memory at creation, it suits dense id spaces such as entity or slot indices.
+ */
+typedef struct SparseSetSt * SparseSet;
+
+
+/**
+ * @brief create an empty sparse set
+ * @note complexity: O(universe)
+ * @param universe number of possible ids, not 0
+ * @return a pointer to the set on success, NULL on failure
+ */
+SparseSet sparse_set__empty(const size_t universe);
+
+
+/**
+ * @brief checks if the set is empty
+ * @note complexity: O(1)
+ * @param s the set
+ * @return 1 if the set is empty, 0 if not, -1 on failure
+ */
+char sparse_set__is_empty(const SparseSet s);
+
+
+/**
+ * @brief number of ids in the set
+ * @note complexity: O(1)
+ * @param s the set
+ * @return the number of ids on success, SIZE_MAX on failure
+ */
+size_t sparse_set__length(const SparseSet s);
+
+
+/**
+ * @brief number of possible ids of the set
+ * @note complexity: O(1)
+ * @param s the set
+ * @return the size of the universe on success, SIZE_MAX on failure
+ */
+size_t sparse_set__universe(const SparseSet s);
+
+
+/**
+ * @brief inserts an id in the set, inserting an id already in the set does nothing
+ * @note complexity: O(1)
+ * @param s the set
+ * @param id the id, less than the universe
+ * @return 0 on success, -1 on failure
+ */
+char sparse_set__insert(const SparseSet s, const size_t id);
+
+
+/**
+ * @brief removes an id from the set
+ * @note complexity: O(1)
+ * @param s the set
+ * @param id the id
+ * @return 0 on success, -1 if the id is not in the set or on failure
+ */
+char sparse_set__remove(const SparseSet s, const size_t id);
+
+
+/**
+ * @brief checks if the id is in the set
+ * @note complexity: O(1)
+ * @param s the set
+ * @param id the id
+ * @return 1 if the id is in the set, 0 if not, -1 on failure
+ */
+char sparse_set__contains(const SparseSet s, const size_t id);
+
+
+/**
+ * @brief dense array of the ids of the set
+ * @details the array holds 'sparse_set__length' ids and belongs to the set, it stays valid until the next
+ * modification of the set
+ * @note complexity: O(1)
+ * @param s the set
+ * @return a pointer to the ids on success, NULL on failure
+ */
+const size_t *sparse_set__ids(const SparseSet s);
+
+
+/**
+ * @brief removes all ids of the set
+ * @note complexity: O(1)
+ * @param s the set
+ */
+void sparse_set__clear(const SparseSet s);
+
+
+/**
+ * @brief frees all allocated memory used by the set
+ * @note complexity: O(1)
+ * @param s the set
+ */
+void sparse_set__free(const SparseSet s);
+
+
+#endif
@@ -3,7 +3,11 @@
 #include <string.h>
 
 #include "stack.h"
+#include "../common/alloc.h"
 #include "../common/vec.h"
+#include "../common/reclaimer.h"
+#include "../common/sort.h"
+#include "../common/sample.h"
 
 #define DEFAULT_STACK_CAPACITY 2
 
@@ -14,13 +18,21 @@
 struct StackSt
 {
     elem_t *elems;
+    size_t front;
     size_t back;
     size_t length;
     size_t capacity;
+    elem_t *old_elems;
+    size_t old_shift;
+    size_t old_end;
+    size_t migrated;
+    char incremental;
+    char reversed;
+    compare_func_t sorted_by;
     char copy_enabled;
     copy_operator_t operator_copy;
     delete_operator_t operator_delete;
-};
+} CACHE_ALIGNED;
 
 ///////////////////////////////////////////////////////////////////////////////
 ///     STACK MACRO UTILITARIES
@@ -39,13 +51,21 @@ static inline void skip(elem_t e) {
  */
 #define STACK_INIT(__copy_op, __delete_op, __n_elems) \
 ({ \
-    Stack __ptr = malloc(sizeof(struct StackSt)); \
+    Stack __ptr = alloc__control(sizeof(struct StackSt)); \
     if (__ptr) { \
-        __ptr->elems = malloc(sizeof(elem_t) * (__n_elems)); \
+        __ptr->elems = alloc__elems(__n_elems); \
         if (__ptr->elems) { \
+            __ptr->front = 0; \
             __ptr->back = 0; \
             __ptr->length = 0; \
             __ptr->capacity = (__n_elems); \
+            __ptr->old_elems = NULL; \
+            __ptr->old_shift = 0; \
+            __ptr->old_end = 0; \
+            __ptr->migrated = 0; \
+            __ptr->incremental = false; \
+            __ptr->reversed = false; \
+            __ptr->sorted_by = NULL; \
             __ptr->copy_enabled = __copy_op ? true : false; \
             __ptr->operator_copy = __copy_op ? __copy_op : id; \
             __ptr->operator_delete = __delete_op ? __delete_op : skip; \
@@ -57,6 +77,26 @@ static inline void skip(elem_t e) {
     __ptr; \
 })
 
+/**
+ * Macro to shift entire stack to the left of the elems array
+ */
+#define STACK_SHIFT(__ptr) \
+    memmove(__ptr->elems, __ptr->elems + __ptr->front, sizeof(elem_t) * __ptr->length); \
+    __ptr->front = 0; \
+    __ptr->back = __ptr->length
+
+/**
+ * Makes room before the front, where a reversed stack has its top
+ */
+static char make_front_room(const Stack s) {
+    size_t front = s->incremental ? INCREMENTAL_RECENTER(s, s->front, DEFAULT_STACK_CAPACITY) : RECENTER(s, s->front);
+    if (front == SIZE_MAX) return FAILURE;
+
+    s->front = front;
+
+    return SUCCESS;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///     STACK FUNCTIONS TO EXPORT
 ///////////////////////////////////////////////////////////////////////////////
@@ -83,15 +123,41 @@ inline size_t stack__length(const Stack s) {
     return !s ? SIZE_MAX : s->length;
 }
 
+char stack__set_incremental_resize(const Stack s, const char enabled) {
+    if (!s) return FAILURE;
+
+    if (!enabled) {
+        MIGRATE_ALL(s, s->front);
+    }
+    s->incremental = enabled ? true : false;
+
+    return SUCCESS;
+}
+
 char stack__push(const Stack s, const elem_t element) {
     if (!s) return FAILURE;
 
-    if (ENSURE_CAPACITY(s) < 0) return FAILURE;
+    if (s->reversed) {
+        if (!s->front && make_front_room(s) < 0) return FAILURE;
+        s->front--;
+        SLOT(s, s->front) = s->operator_copy(element);
+    } else {
+        if (s->incremental && s->back == s->capacity) {
+            if (INCREMENTAL_GROW(s, s->front, DEFAULT_STACK_CAPACITY) < 0) return FAILURE;
+            s->front = 0;
+        } else if (ENSURE_CAPACITY(s) < 0) return FAILURE;
 
-    s->elems[s->length] = s->operator_copy(element);
-    s->back++;
+        SLOT(s, s->back) = s->operator_copy(element);
+        s->back++;
+    }
     s->length++;
 
+    if (s->sorted_by && s->length > 1 && s->sorted_by(&SLOT(s, s->back - 2), &SLOT(s, s->back - 1)) > 0) {
+        s->sorted_by = NULL;
+    }
+
+    MIGRATE(s, s->front, MIGRATE_STEP);
+
     return SUCCESS;
 }
 
@@ -99,28 +165,77 @@ char stack__pop(const Stack s, elem_t *top) {
     size_t new_capacity;
     if (!s || !s->length) return FAILURE;
 
+    size_t pos = ORIENT(s, s->front, s->back, s->back - 1);
     if (top) {
-        *top = s->elems[s->length-1];
+        *top = SLOT(s, pos);
     } else {
-        s->operator_delete(s->elems[s->length-1]);
+        s->operator_delete(SLOT(s, pos));
     }
 
-    s->back--;
+    if (s->reversed) {
+        s->front++;
+    } else {
+        s->back--;
+    }
     s->length--;
 
+    if (s->incremental) {
+        MIGRATE(s, s->front, MIGRATE_STEP);
+        new_capacity = s->capacity>>1;
+        if (!s->old_elems && s->length < new_capacity>>1 && new_capacity >= DEFAULT_STACK_CAPACITY
+                && !REBASE(s, s->front, new_capacity)) {
+            s->front = 0;
+            MIGRATE(s, s->front, MIGRATE_STEP);
+        }
+        return SUCCESS;
+    }
+
     new_capacity = s->capacity>>1;
     if (s->length < new_capacity && new_capacity >= DEFAULT_STACK_CAPACITY) {
+        STACK_SHIFT(s);
         RESIZE(s, new_capacity);
     }
 
     return SUCCESS;
 }
 
+inline size_t stack__mark(const Stack s) {
+    return !s ? SIZE_MAX : s->length;
+}
+
+char stack__rollback(const Stack s, const size_t mark) {
+    if (!s || mark > s->length) return FAILURE;
+
+    /* the elements above the mark are at the front of a reversed stack */
+    size_t start = s->reversed ? s->front : s->front + mark;
+    size_t end = start + s->length - mark;
+
+    if (s->copy_enabled) {
+        for (size_t i = start; i < end; i++) {
+            s->operator_delete(SLOT(s, i));
+        }
+    }
+
+    if (s->reversed) {
+        s->front = end;
+    } else {
+        s->back = start;
+    }
+    s->length = mark;
+
+    /* the buffer is left as is, the following pops shrink it */
+    MIGRATE(s, s->front, MIGRATE_STEP);
+
+    return SUCCESS;
+}
+
 char stack__remove_nth(const Stack s, const size_t i) {
     if (!s || i >= s->length) return FAILURE;
 
-    s->operator_delete(s->elems[i]);
-    s->elems[i] = NULL;
+    size_t k = ORIENT(s, s->front, s->back, s->front + i);
+    s->operator_delete(SLOT(s, k));
+    SLOT(s, k) = NULL;
+    s->sorted_by = NULL;
 
     return SUCCESS;
 }
@@ -128,7 +243,7 @@ char stack__remove_nth(const Stack s, const size_t i) {
 char stack__peek_top(const Stack s, elem_t *top) {
     if (!s || !s->length || !top) return FAILURE;
 
-    *top = s->operator_copy(s->elems[s->length-1]);
+    *top = s->operator_copy(SLOT(s, ORIENT(s, s->front, s->back, s->back - 1)));
 
     return SUCCESS;
 }
@@ -136,7 +251,7 @@ char stack__peek_top(const Stack s, elem_t *top) {
 char stack__peek_nth(const Stack s, const size_t i, elem_t *nth) {
     if (!s || !s->length || !nth || i >= s->length) return FAILURE;
 
-    *nth = s->operator_copy(s->elems[i]);
+    *nth = s->operator_copy(SLOT(s, ORIENT(s, s->front, s->back, s->front + i)));
 
     return SUCCESS;
 }
@@ -144,7 +259,10 @@ char stack__peek_nth(const Stack s, const size_t i, elem_t *nth) {
 char stack__swap(const Stack s, const size_t i, const size_t j) {
     if (!s || i >= s->length || j >= s->length) return FAILURE;
 
-    SWAP(s, i, j);
+    SWAP(s, ORIENT(s, s->front, s->back, s->front + i), ORIENT(s, s->front, s->back, s->front + j));
+    if (i != j) {
+        s->sorted_by = NULL;
+    }
 
     return SUCCESS;
 }
@@ -152,10 +270,17 @@ char stack__swap(const Stack s, const size_t i, const size_t j) {
 Stack stack__copy(const Stack s) {
     if (!s) return NULL;
 
+    MIGRATE_ALL(s, s->front);
+
     Stack copy = STACK_INIT(s->operator_copy, s->operator_delete, s->length);
     if (!copy) return NULL;
 
-    COPY(copy, s, 0, s->length);
+    COPY(copy, s, s->front, s->length);
+
+    copy->back = s->length;
+    copy->incremental = s->incremental;
+    copy->reversed = s->reversed;
+    copy->sorted_by = s->sorted_by;
 
     return copy;
 }
@@ -166,10 +291,13 @@ Stack stack__from_array(Stack s, void *A, const size_t n_elems, const size_t siz
     if (!s) {
         if (!(s = STACK_INIT(NULL, NULL, n_elems))) return NULL;
     } else {
+        MIGRATE_ALL(s, s->front);
+        MATERIALIZE(s, s->front, s->back);
         if (RESIZE(s, s->back + n_elems) < 0) return NULL;
     }
 
     FROM_ARRAY(s, A, n_elems, size);
+    s->sorted_by = NULL;
 
     return s;
 }
@@ -177,12 +305,16 @@ Stack stack__from_array(Stack s, void *A, const size_t n_elems, const size_t siz
 elem_t *stack__dump(const Stack s) {
     if (!s || !s->length) return NULL;
 
+    MIGRATE_ALL(s, s->front);
+    MATERIALIZE(s, s->front, s->back);
+
     elem_t *res = malloc(sizeof(elem_t) * s->length);
     if (!res) return NULL;
 
-    memcpy(res, s->elems, sizeof(elem_t) * s->length);
+    memcpy(res, s->elems + s->front, sizeof(elem_t) * s->length);
     RESIZE(s, DEFAULT_STACK_CAPACITY);
 
+    s->front = 0;
     s->back = 0;
     s->length = 0;
 
@@ -192,15 +324,18 @@ elem_t *stack__dump(const Stack s) {
 elem_t *stack__to_array(const Stack s) {
     if (!s || !s->length) return NULL;
 
+    MIGRATE_ALL(s, s->front);
+    MATERIALIZE(s, s->front, s->back);
+
     elem_t *res = malloc(sizeof(elem_t) * s->length);
     if (!res) return NULL;
 
     if (s->copy_enabled) {
         for (size_t i = 0; i < s->length; i++) {
-            res[i] = s->operator_copy(s->elems[i]);
+            res[i] = s->operator_copy(s->elems[s->front + i]);
         }
     } else {
-        memcpy(res, s->elems, sizeof(elem_t) * s->length);
+        memcpy(res, s->elems + s->front, sizeof(elem_t) * s->length);
     }
 
     return res;
@@ -209,102 +344,326 @@ elem_t *stack__to_array(const Stack s) {
 size_t stack__ptr_search(const Stack s, const elem_t elem) {
     if (!s) return SIZE_MAX;
 
-    return PTR_SEARCH(s, 0, s->length, elem);
+    MIGRATE_ALL(s, s->front);
+
+    size_t pos = PTR_SEARCH(s, s->front, s->back, elem);
+
+    return pos == SIZE_MAX ? SIZE_MAX : pos - s->front;
 }
 
 size_t stack__search(const Stack s, const elem_t elem, const compare_func_t match) {
     if (!s || !match) return SIZE_MAX;
 
-    return SEARCH(s, 0, s->length, elem, match);
+    MIGRATE_ALL(s, s->front);
+
+    size_t pos = SEARCH(s, s->front, s->back, elem, match);
+
+    return pos == SIZE_MAX ? SIZE_MAX : pos - s->front;
 }
 
 char stack__ptr_contains(const Stack s, const elem_t elem) {
     if (!s) return FAILURE;
 
-    return PTR_SEARCH(s, 0, s->length, elem) != SIZE_MAX;
+    MIGRATE_ALL(s, s->front);
+
+    return PTR_SEARCH(s, s->front, s->back, elem) != SIZE_MAX;
 }
 
 char stack__contains(const Stack s, const elem_t elem, const compare_func_t match) {
     if (!s || !match) return FAILURE;
 
-    return SEARCH(s, 0, s->length, elem, match) != SIZE_MAX;
+    MIGRATE_ALL(s, s->front);
+
+    return SEARCH(s, s->front, s->back, elem, match) != SIZE_MAX;
 }
 
 char stack__cmp(const Stack s, const Stack t, const compare_func_t match) {
     if (!s || !t || !match) return FAILURE;
 
+    MIGRATE_ALL(s, s->front);
+    MIGRATE_ALL(t, t->front);
+
     if (s == t) return true;
     if (s->length != t->length) return false;
 
-    return ARRAY_CMP(s->elems, t->elems, match, s->length);
+    return RANGE_CMP(s, s->front, s->back, t, t->front, t->back, match);
 }
 
 char stack__all(const Stack s, const filter_func_t pred, void *user_data) {
     if (!s || !pred) return FAILURE;
 
-    return ALL(s, 0, s->length, pred, user_data);
+    MIGRATE_ALL(s, s->front);
+
+    return ALL(s, s->front, s->back, pred, user_data);
 }
 
 char stack__any(const Stack s, const filter_func_t pred, void *user_data) {
     if (!s || !pred) return FAILURE;
 
-    return ANY(s, 0, s->length, pred, user_data);
+    MIGRATE_ALL(s, s->front);
+
+    return ANY(s, s->front, s->back, pred, user_data);
 }
 
 void stack__foreach(const Stack s, const applying_func_t func, void *user_data) {
     if (!s || !func) return;
 
-    FOREACH(s, func, user_data, 0, s->length);
+    MIGRATE_ALL(s, s->front);
+
+    FOREACH(s, func, user_data, s->front, s->back);
 }
 
 void stack__filter(const Stack s, const filter_func_t pred, void *user_data) {
     if (!s || !pred) return;
 
-    FILTER(s, 0, s->length, pred, user_data);
+    MIGRATE_ALL(s, s->front);
+
+    FILTER(s, s->front, s->back, pred, user_data);
+
+    s->back = s->front + s->length;
 }
 
 void stack__reverse(const Stack s) {
     if (!s || s->length < 2) return;
 
-    for (size_t i = 0, j = s->length - 1; i < j; i++, j--) {
-        SWAP(s, i, j);
-    }
+    s->reversed = !s->reversed;
+    s->sorted_by = NULL;
 }
 
 void stack__shuffle(const Stack s, const unsigned int seed) {
     if (!s) return;
 
-    SHUFFLE(s, 0, s->length, seed);
+    MIGRATE_ALL(s, s->front);
+
+    s->reversed = false;
+    s->sorted_by = NULL;
+    SHUFFLE(s, s->front, s->back, seed);
+}
+
+elem_t *stack__sample(const Stack s, const size_t k, const unsigned int seed) {
+    if (!s || !k || k > s->length) return NULL;
+
+    uint64_t state = sample__seed(seed);
+    elem_t *res = malloc(sizeof(elem_t) * k);
+    size_t *positions = malloc(sizeof(size_t) * k);
+
+    if (!res || !positions || sample__positions(s->length, k, &state, positions) < 0) {
+        free(res);
+        free(positions);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < k; i++) {
+        res[i] = s->operator_copy(SLOT(s, ORIENT(s, s->front, s->back, s->front + positions[i])));
+    }
+
+    free(positions);
+    return res;
 }
 
 void stack__sort(const Stack s, const compare_func_t cmp) {
-    if (!s || !cmp) return;
+    if (!s || !cmp || s->sorted_by == cmp) return;
+
+    MIGRATE_ALL(s, s->front);
+
+    s->reversed = false;
+    s->sorted_by = cmp;
+    sort__hybrid(s->elems + s->front, s->length, cmp);
+}
+
+char stack__sort_by_key(const Stack s, const key_func_t key) {
+    if (!s || !key) return FAILURE;
+
+    MIGRATE_ALL(s, s->front);
+    MATERIALIZE(s, s->front, s->back);
+
+    s->sorted_by = NULL;
+    return sort__by_key(s->elems + s->front, s->length, key);
+}
+
+char stack__sort_by_cached_key(const Stack s, const size_t key_size, const key_extract_func_t extract, const compare_func_t cmp) {
+    if (!s || !key_size || !extract || !cmp) return FAILURE;
+
+    MIGRATE_ALL(s, s->front);
+
+    s->reversed = false;
+    s->sorted_by = NULL;
+    return sort__by_cached_key(s->elems + s->front, s->length, key_size, extract, cmp);
+}
+
+size_t stack__sorted_search(const Stack s, const elem_t elem, const compare_func_t cmp) {
+    if (!s || !cmp) return SIZE_MAX;
+
+    if (s->sorted_by != cmp) {
+        MIGRATE_ALL(s, s->front);
+
+        for (size_t i = 0; i < s->length; i++) {
+            if (!cmp(s->elems + ORIENT(s, s->front, s->back, s->front + i), &elem)) return i;
+        }
+        return SIZE_MAX;
+    }
+
+    size_t pos = LOWER_BOUND(s, s->front, s->back, elem, cmp);
+
+    return (pos < s->back && !cmp(&SLOT(s, pos), &elem)) ? pos - s->front : SIZE_MAX;
+}
+
+char stack__is_sorted(const Stack s, const compare_func_t cmp) {
+    if (!s || !cmp) return FAILURE;
+    if (s->sorted_by == cmp) return true;
 
-    qsort(s->elems, s->length, sizeof(elem_t), cmp);
+    MIGRATE_ALL(s, s->front);
+    MATERIALIZE(s, s->front, s->back);
+
+    if (!IS_SORTED_RANGE(s, s->front, s->back, cmp)) return false;
+
+    s->sorted_by = cmp;
+
+    return true;
 }
 
 void stack__clean_NULL(Stack s) {
     if (!s) return;
 
-    CLEAN_NULL_ELEMS(s, 0, s->length);
+    MIGRATE_ALL(s, s->front);
+
+    CLEAN_NULL_ELEMS(s, s->front, s->back);
+
+    s->back = s->front + s->length;
+}
+
+char stack__compact_elements(const Stack s) {
+    if (!s || !s->copy_enabled) return FAILURE;
+
+    MIGRATE_ALL(s, s->front);
+
+    return COMPACT_ELEMS(s, s->front, s->back);
 }
 
 void stack__clear(const Stack s) {
     if (!s) return;
 
-    FREE_ELEMS(s, 0, s->length);
+    MIGRATE_ALL(s, s->front);
+
+    FREE_ELEMS(s, s->front, s->back);
+    s->reversed = false;
     RESIZE(s, DEFAULT_STACK_CAPACITY);
+
+    s->front = 0;
 }
 
 void stack__free(const Stack s) {
     if (!s) return;
 
-    FREE_ELEMS(s, 0, s->length);
+    MIGRATE_ALL(s, s->front);
+
+    FREE_ELEMS(s, s->front, s->back);
 
     free(s->elems);
     free(s);
 }
 
+void stack__clear_deferred(const Stack s) {
+    if (!s) return;
+
+    MIGRATE_ALL(s, s->front);
+
+    if (!s->copy_enabled || !s->length) {
+        stack__clear(s);
+        return;
+    }
+
+    elem_t *elems = alloc__elems(DEFAULT_STACK_CAPACITY);
+    if (!elems) {
+        stack__clear(s);
+        return;
+    }
+
+    if (reclaimer__defer(s->elems, s->front, s->back, s->operator_delete) < 0) {
+        free(elems);
+        stack__clear(s);
+        return;
+    }
+
+    s->elems = elems;
+    s->capacity = DEFAULT_STACK_CAPACITY;
+    s->reversed = false;
+    s->front = 0;
+    s->back = 0;
+    s->length = 0;
+}
+
+void stack__free_deferred(const Stack s) {
+    if (!s) return;
+
+    MIGRATE_ALL(s, s->front);
+
+    if (!s->copy_enabled || !s->length || reclaimer__defer(s->elems, s->front, s->back, s->operator_delete) < 0) {
+        stack__free(s);
+        return;
+    }
+
+    free(s);
+}
+
+char stack__push_u64(const Stack s, const uint64_t value) {
+    if (!s || s->copy_enabled || !IMMEDIATE_FITS(value)) return FAILURE;
+
+    return stack__push(s, IMMEDIATE_TO_ELEM(value));
+}
+
+char stack__pop_u64(const Stack s, uint64_t *top) {
+    elem_t elem;
+    if (!s || s->copy_enabled) return FAILURE;
+
+    if (stack__pop(s, &elem) < 0) return FAILURE;
+
+    if (top) {
+        *top = ELEM_TO_IMMEDIATE(elem);
+    }
+
+    return SUCCESS;
+}
+
+char stack__peek_nth_u64(const Stack s, const size_t i, uint64_t *nth) {
+    elem_t elem;
+    if (!s || s->copy_enabled || !nth) return FAILURE;
+
+    if (stack__peek_nth(s, i, &elem) < 0) return FAILURE;
+
+    *nth = ELEM_TO_IMMEDIATE(elem);
+
+    return SUCCESS;
+}
+
+size_t stack__search_u64(const Stack s, const uint64_t value) {
+    if (!s || s->copy_enabled || !IMMEDIATE_FITS(value)) return SIZE_MAX;
+
+    MIGRATE_ALL(s, s->front);
+
+    elem_t elem = IMMEDIATE_TO_ELEM(value);
+    size_t pos;
+
+    if (s->sorted_by == immediate_compare) {
+        pos = LOWER_BOUND(s, s->front, s->back, elem, immediate_compare);
+        return (pos < s->back && s->elems[pos] == elem) ? pos - s->front : SIZE_MAX;
+    }
+
+    pos = PTR_SEARCH(s, s->front, s->back, elem);
+
+    return pos == SIZE_MAX ? SIZE_MAX : pos - s->front;
+}
+
+void stack__sort_u64(const Stack s) {
+    if (!s || s->copy_enabled || s->sorted_by == immediate_compare) return;
+
+    MIGRATE_ALL(s, s->front);
+
+    s->reversed = false;
+    s->sorted_by = immediate_compare;
+    IMMEDIATE_SORT(s, s->front, s->back);
+}
+
 void stack__debug(const Stack s, const debug_func_t debug) {
     setvbuf (stdout, NULL, _IONBF, 0);
 
@@ -320,7 +679,7 @@ void stack__debug(const Stack s, const debug_func_t debug) {
         printf("{ ");
         for (size_t i = 0; i < s->capacity; i++) {
             if (i < s->length) {
-                debug(s->elems[i]);
+                debug(SLOT(s, ORIENT(s, s->front, s->back, s->front + i)));
             } else {
                 printf("_ ");
             }
@@ -18,6 +18,25 @@
  * 2) 'stack__peek_top' and 'stack__pop' return a dynamically allocated pointer to an element in the
  * the stack in order to make it survive independently of the stack life cycle.
  * The user has to manually free the return pointer after usage.
+ *
+ * 3) A stack with copy disabled can store unsigned integers directly in its slots, without boxing them.
+ * The '_u64' functions handle such immediate values, they fail on a stack with copy enabled.
+ * Values are stored tagged so that 0 is not taken for a removed element, they must fit in a pointer
+ * minus one bit (63 bits on 64-bit hosts).
+ *
+ * 4) In incremental resize mode, a resize allocates the new buffer without copying the elements, which are then
+ * migrated a few at a time by the following operations. Every O(1) operation then has an O(1) worst-case cost,
+ * the O(n) operations complete the pending migration first.
+ *
+ * 5) 'stack__reverse' only flips the logical direction of the stack, which peek, swap, remove, search and foreach
+ * functions honor. A reversed stack pushes and pops at the front of its buffer, the elements are moved to its middle
+ * when no slot is left before the front, with room proportional to their number. The elements are only physically
+ * reversed by the O(n) operations depending on the order of the buffer, such as 'stack__to_array'.
+ *
+ * 6) A stack remembers the compare function it was last sorted with. Sorting it again with the same function
+ * is then O(1) and 'stack__sorted_search' uses a binary search. The state is kept by the operations preserving
+ * the order (pop, filter, push of an element not less than the last one) and dropped by the others.
+ * Modifying the pointed values of sorted elements behind the stack's back is not detected.
  */
 typedef struct StackSt * Stack;
 
@@ -67,6 +86,17 @@ char stack__is_empty(const Stack s);
 size_t stack__length(const Stack s);
 
 
+/**
+ * @brief enables or disables the incremental resize mode of the stack
+ * @details disabling the mode completes the pending migration
+ * @note complexity: O(1), O(n) when disabling during a migration
+ * @param s the stack
+ * @param enabled true to enable the mode
+ * @return 0 on success, -1 on failure
+ */
+char stack__set_incremental_resize(const Stack s, const char enabled);
+
+
 /**
  * @brief adds an element in the stack
  * @note complexity: O(1)
@@ -88,6 +118,27 @@ char stack__push(const Stack s, const elem_t element);
 char stack__pop(const Stack s, elem_t *top);
 
 
+/**
+ * @brief current depth of the stack, to be given later to 'stack__rollback'
+ * @note complexity: O(1)
+ * @param s the stack
+ * @return the number of elements on success, SIZE_MAX on failure
+ */
+size_t stack__mark(const Stack s);
+
+
+/**
+ * @brief removes all elements pushed above the mark
+ * @details the removed elements are deleted in a single pass, the buffer is not shrunk and is left to the
+ * following pops, which shrink it as usual
+ * @note complexity: O(1) with copy disabled, O(n - mark) with copy enabled
+ * @param s the stack
+ * @param mark a depth returned by 'stack__mark', not greater than the current depth
+ * @return 0 on success, -1 on failure
+ */
+char stack__rollback(const Stack s, const size_t mark);
+
+
 /**
  * @brief remove the element in the nth position
  * @details the deleted item is still part of the stack as a null value instead
@@ -274,7 +325,8 @@ void stack__filter(const Stack s, const filter_func_t pred, void *user_data);
 
 /**
  * @brief reverse the stack
- * @note complexity: O(n)
+ * @details the reversal is logical, the following pushes and pops happen at the other end of the buffer
+ * @note complexity: O(1)
  * @param s the stack
  */
 void stack__reverse(const Stack s);
@@ -289,14 +341,77 @@ void stack__shuffle(const Stack s, const unsigned int seed);
 
 
 /**
- * @brief uses qsort to sort the stack elements using the given compare function
- * @note complexity: O(n*log(n))
+ * @brief retrieves copies of k elements of the stack drawn uniformly without replacement, in random order
+ * @details the array must be manually freed by user afterward. The stack is left unchanged
+ * @note complexity: O(k), independent of the length of the stack
+ * @param s the stack
+ * @param k number of elements to draw, not greater than the length of the stack
+ * @param seed the seed of the random generator
+ * @return a pointer to dynamically allocated array of k elements on success, NULL on failure
+ */
+elem_t *stack__sample(const Stack s, const size_t k, const unsigned int seed);
+
+
+/**
+ * @brief sorts the stack elements using the given compare function
+ * @details already sorted and reverse sorted stacks are detected in linear time, small stacks are insertion sorted
+ * and larger ones use a pattern-defeating quicksort. As with qsort, the sort is not stable
+ * @note complexity: O(n*log(n)), O(1) if the stack is known to be sorted with 'cmp'
  * @param s the stack
  * @param cmp the compare function
  */
 void stack__sort(const Stack s, const compare_func_t cmp);
 
 
+/**
+ * @brief sorts the stack elements by an integer key computed once per element
+ * @details the keys are cached next to their elements and sorted with a stable radix sort,
+ * elements with equal keys keep their relative order
+ * @note complexity: O(n)
+ * @param s the stack
+ * @param key the key function, called exactly once per element
+ * @return 0 on success, -1 on failure
+ */
+char stack__sort_by_key(const Stack s, const key_func_t key);
+
+
+/**
+ * @brief sorts the stack elements by a key extracted once per element
+ * @details the keys are cached next to their elements in a side array sorted with qsort, so that 'cmp'
+ * compares the cached keys and never dereferences the elements. 'cmp' receives pointers to keys
+ * @note complexity: O(n*log(n))
+ * @param s the stack
+ * @param key_size byte size of a key
+ * @param extract the extraction function, called exactly once per element
+ * @param cmp the compare function
+ * @return 0 on success, -1 on failure
+ */
+char stack__sort_by_cached_key(const Stack s, const size_t key_size, const key_extract_func_t extract, const compare_func_t cmp);
+
+
+/**
+ * @brief search an element with the compare function
+ * @details the search is binary if the stack is known to be sorted with 'cmp', linear otherwise
+ * @note complexity: O(log(n)) if the stack is known to be sorted with 'cmp', O(n) otherwise
+ * @param s the stack
+ * @param elem the element to search
+ * @param cmp the compare function, receives pointers to elements as with qsort
+ * @return the position of the first element comparing equal to 'elem' if there is one, SIZE_MAX if not, SIZE_MAX on failure
+ */
+size_t stack__sorted_search(const Stack s, const elem_t elem, const compare_func_t cmp);
+
+
+/**
+ * @brief checks if the stack is sorted with the compare function
+ * @details a stack found sorted is then known to be sorted with 'cmp'
+ * @note complexity: O(1) if the stack is known to be sorted with 'cmp', O(n) otherwise
+ * @param s the stack
+ * @param cmp the compare function
+ * @return 1 if the stack is sorted, 0 if not, -1 on failure
+ */
+char stack__is_sorted(const Stack s, const compare_func_t cmp);
+
+
 /**
  * @brief removes all NULL pointers in the stack
  * @note complexity: O(n)
@@ -305,6 +420,18 @@ void stack__sort(const Stack s, const compare_func_t cmp);
 void stack__clean_NULL(const Stack s);
 
 
+/**
+ * @brief re-copies all elements of the stack in container order
+ * @details every element is copied with the copy operator before the old ones are deleted, the placement of
+ * the copies is left to the allocator. Pointers to the old elements, e.g. kept from 'stack__foreach',
+ * are invalidated. On failure the stack is left unaltered
+ * @note complexity: O(n)
+ * @param s the stack, with copy enabled
+ * @return 0 on success, -1 on failure
+ */
+char stack__compact_elements(const Stack s);
+
+
 /**
  * @brief removes all elements in the stack
  * @details if copy is enabled frees all allocated memory used by these elements, the stack is still usable afterwards
@@ -323,6 +450,75 @@ void stack__clear(const Stack s);
 void stack__free(const Stack s);
 
 
+/**
+ * @brief removes all elements in the stack, handing their destruction to the background reclaimer
+ * @details if copy is enabled the detached elements are deleted on the reclaimer thread, the delete operator must
+ * therefore be thread-safe. Falls back to 'stack__clear' if the reclaimer is unavailable
+ * @note complexity: O(1), plus O(m) in incremental resize mode where m is the number of elements not yet migrated
+ * @param s the stack
+ */
+void stack__clear_deferred(const Stack s);
+
+
+/**
+ * @brief frees all allocated memory used by the stack, handing the destruction of its elements to the background reclaimer
+ * @details if copy is enabled the elements are deleted on the reclaimer thread, the delete operator must
+ * therefore be thread-safe. Falls back to 'stack__free' if the reclaimer is unavailable
+ * @note complexity: O(1), plus O(m) in incremental resize mode where m is the number of elements not yet migrated
+ * @param s the stack
+ */
+void stack__free_deferred(const Stack s);
+
+
+/**
+ * @brief adds an immediate value in the stack
+ * @note complexity: O(1)
+ * @param s the stack, with copy disabled
+ * @param value the value to add, which must fit in a pointer minus one bit
+ * @return 0 on success, -1 on failure
+ */
+char stack__push_u64(const Stack s, const uint64_t value);
+
+
+/**
+ * @brief removes the top immediate value of the stack
+ * @note complexity: O(1)
+ * @param s the stack, with copy disabled
+ * @param top pointer to storage variable, can be NULL
+ * @return 0 on success, -1 on failure
+ */
+char stack__pop_u64(const Stack s, uint64_t *top);
+
+
+/**
+ * @brief retrieve the immediate value at 'i' position of the stack without removing it
+ * @note complexity: O(1)
+ * @param s the stack, with copy disabled
+ * @param i position
+ * @param nth pointer to storage variable
+ * @return 0 on success, -1 on failure
+ */
+char stack__peek_nth_u64(const Stack s, const size_t i, uint64_t *nth);
+
+
+/**
+ * @brief search the given immediate value
+ * @note complexity: O(n), O(log(n)) once sorted with 'stack__sort_u64'
+ * @param s the stack, with copy disabled
+ * @param value the value to search
+ * @return the position of the value in the stack if it is contained in it, SIZE_MAX if not, SIZE_MAX on failure
+ */
+size_t stack__search_u64(const Stack s, const uint64_t value);
+
+
+/**
+ * @brief sorts the immediate values of the stack in ascending order
+ * @note complexity: O(n*log(n))
+ * @param s the stack, with copy disabled
+ */
+void stack__sort_u64(const Stack s);
+
+
 /**
  * @brief prints the stack's content
  * @note complexity: O(n)
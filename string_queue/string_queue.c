@@ -0,0 +1,375 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "string_queue.h"
+
+#define DEFAULT_STRING_QUEUE_CAPACITY 4
+#define DEFAULT_POOL_CAPACITY 64
+#define PREFIX_SIZE 8
+
+///////////////////////////////////////////////////////////////////////////////
+///     STRING QUEUE STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    size_t offset;
+    size_t length;
+    char prefix[PREFIX_SIZE];
+} StringDesc;
+
+struct StringQueueSt
+{
+    StringDesc *descs;
+    size_t front;
+    size_t back;
+    size_t length;
+    size_t capacity;
+    char *pool;
+    size_t pool_length;
+    size_t pool_capacity;
+    size_t live_bytes;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     STRING QUEUE MACRO UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Macro to access the bytes of a descriptor
+ */
+#define DESC_STR(__ptr, __desc) \
+    ((__ptr)->pool + (__desc)->offset)
+
+/**
+ * Macro to shift entire queue to the left of the descriptors array
+ */
+#define STRING_QUEUE_SHIFT(__ptr) \
+    memmove((__ptr)->descs, (__ptr)->descs + (__ptr)->front, sizeof(StringDesc) * (__ptr)->length); \
+    (__ptr)->front = 0; \
+    (__ptr)->back = (__ptr)->length
+
+static inline void desc_init(StringDesc *desc, const char *str, const size_t offset, const size_t len) {
+    desc->offset = offset;
+    desc->length = len;
+    memset(desc->prefix, 0, PREFIX_SIZE);
+    memcpy(desc->prefix, str, len < PREFIX_SIZE ? len : PREFIX_SIZE);
+}
+
+/**
+ * Lexicographic byte order, the pool is only read when the prefixes are equal
+ */
+static int desc_cmp(const char *pool, const StringDesc *a, const StringDesc *b) {
+    size_t n = a->length < b->length ? a->length : b->length;
+    int res = memcmp(a->prefix, b->prefix, n < PREFIX_SIZE ? n : PREFIX_SIZE);
+
+    if (!res && n > PREFIX_SIZE) {
+        res = memcmp(pool + a->offset + PREFIX_SIZE, pool + b->offset + PREFIX_SIZE, n - PREFIX_SIZE);
+    }
+
+    return res ? res : (a->length > b->length) - (a->length < b->length);
+}
+
+/**
+ * Stable merge sort of descs[lo, hi) using tmp as scratch space
+ */
+static void descs_sort(const char *pool, StringDesc *descs, StringDesc *tmp, size_t lo, size_t hi) {
+    size_t mid, i, j, k;
+    StringDesc desc;
+
+    if (hi - lo <= 8) {
+        for (i = lo + 1; i < hi; i++) {
+            desc = descs[i];
+            for (j = i; j > lo && desc_cmp(pool, &desc, descs + j - 1) < 0; j--) {
+                descs[j] = descs[j - 1];
+            }
+            descs[j] = desc;
+        }
+        return;
+    }
+
+    mid = lo + ((hi - lo)>>1);
+    descs_sort(pool, descs, tmp, lo, mid);
+    descs_sort(pool, descs, tmp, mid, hi);
+
+    if (desc_cmp(pool, descs + mid - 1, descs + mid) <= 0) return;
+
+    memcpy(tmp + lo, descs + lo, sizeof(StringDesc) * (hi - lo));
+    for (i = lo, j = mid, k = lo; k < hi; k++) {
+        if (j == hi || (i < mid && desc_cmp(pool, tmp + i, tmp + j) <= 0)) {
+            descs[k] = tmp[i++];
+        } else {
+            descs[k] = tmp[j++];
+        }
+    }
+}
+
+/**
+ * Rewrites the live strings at the beginning of a new pool, in queue order
+ */
+static char pool_compact(const StringQueue q, const size_t min_capacity) {
+    size_t capacity = DEFAULT_POOL_CAPACITY;
+    while (capacity < min_capacity) capacity <<= 1;
+
+    char *pool = malloc(capacity);
+    if (!pool) return FAILURE;
+
+    size_t offset = 0;
+    for (size_t i = q->front; i < q->back; i++) {
+        memcpy(pool + offset, DESC_STR(q, q->descs + i), q->descs[i].length + 1);
+        q->descs[i].offset = offset;
+        offset += q->descs[i].length + 1;
+    }
+
+    free(q->pool);
+    q->pool = pool;
+    q->pool_length = offset;
+    q->pool_capacity = capacity;
+
+    return SUCCESS;
+}
+
+/**
+ * Makes room for 'n' more bytes in the pool, compacting it when most of its bytes are dead
+ * unless the offsets must be preserved
+ */
+static char pool_reserve(const StringQueue q, const size_t n, const char keep_offsets) {
+    if (q->pool_length + n <= q->pool_capacity) return SUCCESS;
+
+    if (!keep_offsets && q->pool_length - q->live_bytes >= q->live_bytes) {
+        return pool_compact(q, (q->live_bytes + n)<<1);
+    }
+
+    size_t capacity = q->pool_capacity<<1;
+    while (capacity < q->pool_length + n) capacity <<= 1;
+
+    char *pool = realloc(q->pool, capacity);
+    if (!pool) return FAILURE;
+
+    q->pool = pool;
+    q->pool_capacity = capacity;
+
+    return SUCCESS;
+}
+
+/**
+ * Forgets the bytes of a removed string, resetting the pool once the queue is empty
+ */
+static void pool_release(const StringQueue q, const StringDesc *desc) {
+    q->live_bytes -= desc->length + 1;
+    if (!q->length) {
+        q->pool_length = 0;
+    } else if (desc->offset + desc->length + 1 == q->pool_length) {
+        q->pool_length = desc->offset;
+    }
+}
+
+static char desc_extract(const StringQueue q, const StringDesc *desc, char **str) {
+    if (!str) return SUCCESS;
+
+    *str = malloc(desc->length + 1);
+    if (!*str) return FAILURE;
+    memcpy(*str, DESC_STR(q, desc), desc->length + 1);
+
+    return SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     STRING QUEUE FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+StringQueue string_queue__empty(void) {
+    StringQueue q = malloc(sizeof(struct StringQueueSt));
+    if (!q) return NULL;
+
+    q->descs = malloc(sizeof(StringDesc) * DEFAULT_STRING_QUEUE_CAPACITY);
+    q->pool = malloc(DEFAULT_POOL_CAPACITY);
+    if (!q->descs || !q->pool) {
+        free(q->descs);
+        free(q->pool);
+        free(q);
+        return NULL;
+    }
+
+    q->front = 0;
+    q->back = 0;
+    q->length = 0;
+    q->capacity = DEFAULT_STRING_QUEUE_CAPACITY;
+    q->pool_length = 0;
+    q->pool_capacity = DEFAULT_POOL_CAPACITY;
+    q->live_bytes = 0;
+
+    return q;
+}
+
+inline char string_queue__is_empty(const StringQueue q) {
+    return !q ? FAILURE : !q->length;
+}
+
+inline size_t string_queue__length(const StringQueue q) {
+    return !q ? SIZE_MAX : q->length;
+}
+
+char string_queue__enqueue(const StringQueue q, const char *str) {
+    if (!q || !str) return FAILURE;
+
+    return string_queue__enqueue_n(q, str, strlen(str));
+}
+
+char string_queue__enqueue_n(const StringQueue q, const char *str, const size_t len) {
+    if (!q || !str) return FAILURE;
+
+    if (q->back == q->capacity) {
+        if (q->front >= q->capacity>>1) {
+            STRING_QUEUE_SHIFT(q);
+        } else {
+            StringDesc *descs = realloc(q->descs, sizeof(StringDesc) * (q->capacity<<1));
+            if (!descs) return FAILURE;
+            q->descs = descs;
+            q->capacity <<= 1;
+        }
+    }
+
+    /* the string can come from 'string_queue__peek_nth' and move with the pool */
+    char in_pool = str >= q->pool && str < q->pool + q->pool_length;
+    size_t str_offset = in_pool ? (size_t)(str - q->pool) : 0;
+
+    if (pool_reserve(q, len + 1, in_pool) < 0) return FAILURE;
+
+    if (in_pool) {
+        str = q->pool + str_offset;
+    }
+
+    memcpy(q->pool + q->pool_length, str, len);
+    q->pool[q->pool_length + len] = '\0';
+
+    desc_init(q->descs + q->back, str, q->pool_length, len);
+    q->pool_length += len + 1;
+    q->live_bytes += len + 1;
+    q->back++;
+    q->length++;
+
+    return SUCCESS;
+}
+
+char string_queue__dequeue(const StringQueue q, char **front) {
+    if (!q || !q->length) return FAILURE;
+
+    StringDesc *desc = q->descs + q->front;
+    if (desc_extract(q, desc, front) < 0) return FAILURE;
+
+    q->front++;
+    q->length--;
+    pool_release(q, desc);
+
+    if (!q->length) {
+        q->front = 0;
+        q->back = 0;
+    }
+
+    return SUCCESS;
+}
+
+char string_queue__pop_back(const StringQueue q, char **back) {
+    if (!q || !q->length) return FAILURE;
+
+    StringDesc *desc = q->descs + q->back - 1;
+    if (desc_extract(q, desc, back) < 0) return FAILURE;
+
+    q->back--;
+    q->length--;
+    pool_release(q, desc);
+
+    if (!q->length) {
+        q->front = 0;
+        q->back = 0;
+    }
+
+    return SUCCESS;
+}
+
+char string_queue__peek_nth(const StringQueue q, const size_t i, const char **str, size_t *len) {
+    if (!q || !str || i >= q->length) return FAILURE;
+
+    *str = DESC_STR(q, q->descs + q->front + i);
+    if (len) {
+        *len = q->descs[q->front + i].length;
+    }
+
+    return SUCCESS;
+}
+
+size_t string_queue__search(const StringQueue q, const char *str) {
+    if (!q || !str) return SIZE_MAX;
+
+    StringDesc key;
+    size_t len = strlen(str);
+    desc_init(&key, str, 0, len);
+
+    for (size_t i = q->front; i < q->back; i++) {
+        const StringDesc *desc = q->descs + i;
+        if (desc->length == len && !memcmp(desc->prefix, key.prefix, PREFIX_SIZE)
+            && (len <= PREFIX_SIZE || !memcmp(DESC_STR(q, desc) + PREFIX_SIZE, str + PREFIX_SIZE, len - PREFIX_SIZE))) {
+            return i - q->front;
+        }
+    }
+
+    return SIZE_MAX;
+}
+
+char string_queue__contains(const StringQueue q, const char *str) {
+    if (!q || !str) return FAILURE;
+
+    return string_queue__search(q, str) != SIZE_MAX;
+}
+
+void string_queue__sort(const StringQueue q) {
+    if (!q || q->length < 2) return;
+
+    StringDesc *tmp = malloc(sizeof(StringDesc) * q->back);
+    if (!tmp) return;
+
+    descs_sort(q->pool, q->descs, tmp, q->front, q->back);
+
+    free(tmp);
+}
+
+void string_queue__clear(const StringQueue q) {
+    if (!q) return;
+
+    q->front = 0;
+    q->back = 0;
+    q->length = 0;
+    q->pool_length = 0;
+    q->live_bytes = 0;
+}
+
+void string_queue__free(const StringQueue q) {
+    if (!q) return;
+
+    free(q->descs);
+    free(q->pool);
+    free(q);
+}
+
+void string_queue__debug(const StringQueue q) {
+    setvbuf (stdout, NULL, _IONBF, 0);
+
+    printf("\n");
+    if (!q) {
+        printf("\tInvalid queue (NULL)");
+    } else {
+        printf("\tString queue:");
+        printf("\n\tQueue size: %lu\n\tQueue capacity: %lu\n\tPool size: %lu\n\tPool capacity: %lu\n\tQueue content: \n\t", q->length
+                                                                                                                          , q->capacity
+                                                                                                                          , q->pool_length
+                                                                                                                          , q->pool_capacity);
+        printf("{ ");
+        for (size_t i = q->front; i < q->back; i++) {
+            printf("\"%s\" ", DESC_STR(q, q->descs + i));
+        }
+        printf("}");
+    }
+    printf("\n");
+}
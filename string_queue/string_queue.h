@@ -0,0 +1,165 @@
+#ifndef __STRING_QUEUE_H__
+#define __STRING_QUEUE_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a FIFO Abstract Data Type specialized for strings
+ *
+ * Notes :
+ * 1) The bytes of all strings are appended to a single growing pool, each element of the queue is a
+ * descriptor holding the offset, the length and the first bytes of its string. Enqueuing a string
+ * never allocates memory once the pool is large enough, and comparisons only read the pool when
+ * the inlined prefixes are equal.
+ *
+ * 2) 'string_queue__dequeue' and 'string_queue__pop_back' return a dynamically allocated copy of the
+ * string in order to make it survive independently of the queue life cycle.
+ * The user has to manually free the returned pointer after usage.
+ *
+ * 3) 'string_queue__peek_nth' gives access to the string inside the pool without copy, the pointer
+ * is invalidated by any function adding or removing elements. Every string of the pool is NUL-terminated.
+ *
+ * 4) Positions are relative to the front of the queue: the front element is at position 0.
+ * The queue can also be used as a stack through 'string_queue__pop_back'.
+ */
+typedef struct StringQueueSt * StringQueue;
+
+
+/**
+ * @brief create an empty string queue
+ * @note complexity: O(1)
+ * @return a pointer to queue on success, NULL on failure
+ */
+StringQueue string_queue__empty(void);
+
+
+/**
+ * @brief checks if the queue is empty
+ * @note complexity: O(1)
+ * @param q the queue
+ * @return 1 if the queue is empty, 0 if not, -1 on failure
+ */
+char string_queue__is_empty(const StringQueue q);
+
+
+/**
+ * @brief number of strings in the queue
+ * @note complexity: O(1)
+ * @param q the queue
+ * @return the number of strings contained in the queue on success, SIZE_MAX on failure
+ */
+size_t string_queue__length(const StringQueue q);
+
+
+/**
+ * @brief adds a copy of a NUL-terminated string in the queue
+ * @note complexity: O(m) where m is the length of the string
+ * @param q the queue
+ * @param str the string
+ * @return 0 on success, -1 on failure
+ */
+char string_queue__enqueue(const StringQueue q, const char *str);
+
+
+/**
+ * @brief adds a copy of the first 'len' bytes of a string in the queue
+ * @note complexity: O(len)
+ * @param q the queue
+ * @param str the string
+ * @param len number of bytes to copy
+ * @return 0 on success, -1 on failure
+ */
+char string_queue__enqueue_n(const StringQueue q, const char *str, const size_t len);
+
+
+/**
+ * @brief removes the front string of the queue
+ * @details if 'front' is not NULL it receives a copy of the string which must be manually freed by user afterward
+ * @note complexity: O(m) where m is the length of the string
+ * @param q the queue
+ * @param front pointer to storage variable, can be NULL
+ * @return 0 on success, -1 on failure
+ */
+char string_queue__dequeue(const StringQueue q, char **front);
+
+
+/**
+ * @brief removes the back string of the queue
+ * @details if 'back' is not NULL it receives a copy of the string which must be manually freed by user afterward
+ * @note complexity: O(m) where m is the length of the string
+ * @param q the queue
+ * @param back pointer to storage variable, can be NULL
+ * @return 0 on success, -1 on failure
+ */
+char string_queue__pop_back(const StringQueue q, char **back);
+
+
+/**
+ * @brief retrieve the string at 'i' position of the queue without copying it
+ * @note complexity: O(1)
+ * @param q the queue
+ * @param i position
+ * @param str pointer to storage variable of the string
+ * @param len pointer to storage variable of the length, can be NULL
+ * @return 0 on success, -1 on failure
+ */
+char string_queue__peek_nth(const StringQueue q, const size_t i, const char **str, size_t *len);
+
+
+/**
+ * @brief search the given NUL-terminated string
+ * @note complexity: O(n)
+ * @param q the queue
+ * @param str the string to search
+ * @return the position of the string in the queue if it is contained in it, SIZE_MAX if not, SIZE_MAX on failure
+ */
+size_t string_queue__search(const StringQueue q, const char *str);
+
+
+/**
+ * @brief checks if a given NUL-terminated string is on the queue
+ * @note complexity: O(n)
+ * @param q the queue
+ * @param str the string
+ * @return 1 if the string is on the queue, 0 if not, -1 on failure
+ */
+char string_queue__contains(const StringQueue q, const char *str);
+
+
+/**
+ * @brief sorts the strings of the queue in lexicographic byte order
+ * @note complexity: O(n*log(n))
+ * @param q the queue
+ */
+void string_queue__sort(const StringQueue q);
+
+
+/**
+ * @brief removes all strings in the queue
+ * @details the memory of the pool is kept for the next strings
+ * @note complexity: O(1)
+ * @param q the queue
+ */
+void string_queue__clear(const StringQueue q);
+
+
+/**
+ * @brief frees all allocated memory used by the queue
+ * @note complexity: O(1)
+ * @param q the queue
+ */
+void string_queue__free(const StringQueue q);
+
+
+/**
+ * @brief prints the queue's content
+ * @note complexity: O(n)
+ * @param q the queue
+ */
+void string_queue__debug(const StringQueue q);
+
+
+#endif
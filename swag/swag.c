@@ -0,0 +1,198 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "swag.h"
+#include "../stack/stack.h"
+
+///////////////////////////////////////////////////////////////////////////////
+///     SWAG STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+struct SwagSt
+{
+    Stack front;
+    Stack front_aggs;
+    Stack back;
+    elem_t back_agg;
+    elem_t result;
+    char has_result;
+    bin_applying_func_t op;
+    elem_t identity;
+    void *user_data;
+    delete_operator_t operator_delete;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     SWAG UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+static inline void drop(const Swag w, const elem_t aggregate) {
+    if (w->operator_delete) w->operator_delete(aggregate);
+}
+
+static inline void drop_result(const Swag w) {
+    if (w->has_result) drop(w, w->result);
+    w->has_result = false;
+}
+
+/**
+ * Deletes the suffix aggregates of the front stack and empties both front stacks
+ */
+static void clear_front(const Swag w) {
+    elem_t aggregate;
+
+    while (!stack__pop(w->front_aggs, &aggregate)) {
+        drop(w, aggregate);
+    }
+    stack__clear(w->front);
+}
+
+/**
+ * Moves the back stack onto the empty front stack, from the newest element to the oldest,
+ * each element being stored with the aggregate of itself and the newer elements.
+ * The window is left unchanged on failure
+ */
+static char flip(const Swag w) {
+    elem_t elem, aggregate, below = w->identity;
+    size_t n = stack__length(w->back);
+
+    for (size_t i = n; i > 0; i--) {
+        stack__peek_nth(w->back, i - 1, &elem);
+        aggregate = w->op(elem, below, w->user_data);
+
+        if (stack__push(w->front_aggs, aggregate) < 0) {
+            drop(w, aggregate);
+            clear_front(w);
+            return FAILURE;
+        }
+        if (stack__push(w->front, elem) < 0) {
+            clear_front(w);
+            return FAILURE;
+        }
+        below = aggregate;
+    }
+
+    drop(w, w->back_agg);
+    w->back_agg = w->identity;
+    stack__clear(w->back);
+
+    return SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     SWAG FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+Swag swag__empty(const bin_applying_func_t op, const elem_t identity, void *user_data, const delete_operator_t delete_op) {
+    if (!op) return NULL;
+
+    Swag w = malloc(sizeof(struct SwagSt));
+    if (!w) return NULL;
+
+    w->front = stack__empty_copy_disabled();
+    w->front_aggs = stack__empty_copy_disabled();
+    w->back = stack__empty_copy_disabled();
+    if (!w->front || !w->front_aggs || !w->back) {
+        stack__free(w->front);
+        stack__free(w->front_aggs);
+        stack__free(w->back);
+        free(w);
+        return NULL;
+    }
+
+    w->back_agg = identity;
+    w->result = identity;
+    w->has_result = false;
+    w->op = op;
+    w->identity = identity;
+    w->user_data = user_data;
+    w->operator_delete = delete_op;
+
+    return w;
+}
+
+inline char swag__is_empty(const Swag w) {
+    return w ? (stack__is_empty(w->front) && stack__is_empty(w->back)) : FAILURE;
+}
+
+inline size_t swag__length(const Swag w) {
+    return w ? stack__length(w->front) + stack__length(w->back) : SIZE_MAX;
+}
+
+char swag__push(const Swag w, const elem_t element) {
+    if (!w) return FAILURE;
+
+    elem_t aggregate = w->op(w->back_agg, element, w->user_data);
+
+    if (stack__push(w->back, element) < 0) {
+        drop(w, aggregate);
+        return FAILURE;
+    }
+
+    drop_result(w);
+    if (stack__length(w->back) > 1) drop(w, w->back_agg);
+    w->back_agg = aggregate;
+
+    return SUCCESS;
+}
+
+char swag__pop(const Swag w, elem_t *front) {
+    elem_t elem, aggregate;
+    if (!w || swag__is_empty(w)) return FAILURE;
+
+    if (stack__is_empty(w->front) && flip(w) < 0) return FAILURE;
+
+    drop_result(w);
+    stack__pop(w->front, &elem);
+    stack__pop(w->front_aggs, &aggregate);
+    drop(w, aggregate);
+
+    if (front) *front = elem;
+
+    return SUCCESS;
+}
+
+char swag__query(const Swag w, elem_t *aggregate) {
+    elem_t suffix;
+    if (!w || !aggregate) return FAILURE;
+
+    if (stack__is_empty(w->front)) {
+        *aggregate = w->back_agg;
+        return SUCCESS;
+    }
+
+    stack__peek_top(w->front_aggs, &suffix);
+
+    if (stack__is_empty(w->back)) {
+        *aggregate = suffix;
+        return SUCCESS;
+    }
+
+    if (!w->has_result) {
+        w->result = w->op(suffix, w->back_agg, w->user_data);
+        w->has_result = true;
+    }
+    *aggregate = w->result;
+
+    return SUCCESS;
+}
+
+void swag__clear(const Swag w) {
+    if (!w) return;
+
+    drop_result(w);
+    clear_front(w);
+    if (!stack__is_empty(w->back)) drop(w, w->back_agg);
+    w->back_agg = w->identity;
+    stack__clear(w->back);
+}
+
+void swag__free(const Swag w) {
+    if (!w) return;
+
+    swag__clear(w);
+    stack__free(w->front);
+    stack__free(w->front_aggs);
+    stack__free(w->back);
+    free(w);
+}
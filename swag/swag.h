@@ -0,0 +1,107 @@
+#ifndef __SWAG_H__
+#define __SWAG_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a sliding window aggregator (SWAG) over a FIFO window, built from two stacks
+ *
+ * Notes :
+ * 1) The aggregation function must be associative, it does not need to be commutative:
+ * the aggregate of the window x1, ..., xn (from the oldest) is op(x1, op(x2, ... op(xn-1, xn))).
+ * Elements and aggregates have the same type, 'identity' is the neutral element of the function.
+ * The function receives the user data given at creation as last argument.
+ *
+ * 2) New elements are pushed on the back stack, whose running aggregate is kept. Elements are popped
+ * from the front stack, which stores the aggregate of every element with the elements pushed after it.
+ * When the front stack is empty, the back stack is flipped onto it. Each element is flipped once,
+ * push, pop and query therefore cost O(1) amortized calls to the aggregation function.
+ *
+ * 3) The window never copies nor deletes its elements, they are given back by 'swag__pop'.
+ * The aggregates returned by the function are owned by the window and deleted with the delete operator, if any.
+ * The identity is never deleted.
+ */
+typedef struct SwagSt * Swag;
+
+
+/**
+ * @brief create an empty window
+ * @note complexity: O(1)
+ * @param op the associative aggregation function
+ * @param identity the neutral element of the aggregation function
+ * @param user_data the user data given to the aggregation function
+ * @param delete_op the delete operator of the aggregates, NULL if they are not owned
+ * @return a pointer to the window on success, NULL on failure
+ */
+Swag swag__empty(const bin_applying_func_t op, const elem_t identity, void *user_data, const delete_operator_t delete_op);
+
+
+/**
+ * @brief checks if the window is empty
+ * @note complexity: O(1)
+ * @param w the window
+ * @return 1 if the window is empty, 0 if not, -1 on failure
+ */
+char swag__is_empty(const Swag w);
+
+
+/**
+ * @brief number of elements in the window
+ * @note complexity: O(1)
+ * @param w the window
+ * @return the number of elements on success, SIZE_MAX on failure
+ */
+size_t swag__length(const Swag w);
+
+
+/**
+ * @brief pushes an element at the back of the window
+ * @note complexity: O(1)
+ * @param w the window
+ * @param element the element
+ * @return 0 on success, -1 on failure
+ */
+char swag__push(const Swag w, const elem_t element);
+
+
+/**
+ * @brief removes the oldest element of the window
+ * @note complexity: O(1) amortized, O(n) when the back stack is flipped
+ * @param w the window
+ * @param front pointer to storage variable, can be NULL
+ * @return 0 on success, -1 on failure
+ */
+char swag__pop(const Swag w, elem_t *front);
+
+
+/**
+ * @brief aggregate of all elements of the window, the identity if the window is empty
+ * @details the aggregate is owned by the window and stays valid until its next modification
+ * @note complexity: O(1)
+ * @param w the window
+ * @param aggregate pointer to storage variable
+ * @return 0 on success, -1 on failure
+ */
+char swag__query(const Swag w, elem_t *aggregate);
+
+
+/**
+ * @brief removes all elements of the window
+ * @note complexity: O(n)
+ * @param w the window
+ */
+void swag__clear(const Swag w);
+
+
+/**
+ * @brief frees all allocated memory used by the window and deletes the aggregates
+ * @note complexity: O(n)
+ * @param w the window
+ */
+void swag__free(const Swag w);
+
+
+#endif
@@ -0,0 +1,265 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "table.h"
+
+#define DEFAULT_TABLE_CAPACITY 4
+
+///////////////////////////////////////////////////////////////////////////////
+///     TABLE STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+struct TableSt
+{
+    char **columns;
+    size_t *sizes;
+    size_t n_columns;
+    size_t length;
+    size_t capacity;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     TABLE MACRO UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Macro to access the address of a value
+ */
+#define CELL(__ptr, __column, __i) \
+    ((__ptr)->columns[__column] + (__ptr)->sizes[__column] * (__i))
+
+/**
+ * Resizes every column, on failure the capacity is set to the smallest size shared by all columns
+ */
+static char table_resize(const Table t, const size_t new_capacity) {
+    char *column;
+
+    for (size_t c = 0; c < t->n_columns; c++) {
+        column = realloc(t->columns[c], t->sizes[c] * new_capacity);
+        if (!column) {
+            if (new_capacity < t->capacity) t->capacity = new_capacity;
+            return FAILURE;
+        }
+        t->columns[c] = column;
+    }
+    t->capacity = new_capacity;
+
+    return SUCCESS;
+}
+
+/**
+ * Stable merge sort of rows[lo, hi) by the values of a column, using tmp as scratch space
+ */
+static void rows_sort(const Table t, const size_t column, const compare_func_t cmp, size_t *rows, size_t *tmp, size_t lo, size_t hi) {
+    size_t mid, i, j, k, row;
+
+    if (hi - lo < 2) return;
+
+    if (hi - lo <= 8) {
+        for (i = lo + 1; i < hi; i++) {
+            row = rows[i];
+            for (j = i; j > lo && cmp(CELL(t, column, row), CELL(t, column, rows[j - 1])) < 0; j--) {
+                rows[j] = rows[j - 1];
+            }
+            rows[j] = row;
+        }
+        return;
+    }
+
+    mid = lo + ((hi - lo)>>1);
+    rows_sort(t, column, cmp, rows, tmp, lo, mid);
+    rows_sort(t, column, cmp, rows, tmp, mid, hi);
+
+    if (cmp(CELL(t, column, rows[mid - 1]), CELL(t, column, rows[mid])) <= 0) return;
+
+    memcpy(tmp + lo, rows + lo, sizeof(size_t) * (hi - lo));
+    for (i = lo, j = mid, k = lo; k < hi; k++) {
+        if (j == hi || (i < mid && cmp(CELL(t, column, tmp[i]), CELL(t, column, tmp[j])) <= 0)) {
+            rows[k] = tmp[i++];
+        } else {
+            rows[k] = tmp[j++];
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     TABLE FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+Table table__empty(const size_t n_columns, const size_t *column_sizes) {
+    if (!n_columns || !column_sizes) return NULL;
+
+    for (size_t c = 0; c < n_columns; c++) {
+        if (!column_sizes[c]) return NULL;
+    }
+
+    Table t = malloc(sizeof(struct TableSt));
+    if (!t) return NULL;
+
+    t->columns = calloc(n_columns, sizeof(char *));
+    t->sizes = malloc(sizeof(size_t) * n_columns);
+    t->n_columns = n_columns;
+    t->length = 0;
+    t->capacity = 0;
+
+    if (!t->columns || !t->sizes) {
+        table__free(t);
+        return NULL;
+    }
+
+    memcpy(t->sizes, column_sizes, sizeof(size_t) * n_columns);
+
+    if (table_resize(t, DEFAULT_TABLE_CAPACITY) < 0) {
+        table__free(t);
+        return NULL;
+    }
+
+    return t;
+}
+
+inline char table__is_empty(const Table t) {
+    return !t ? FAILURE : !t->length;
+}
+
+inline size_t table__length(const Table t) {
+    return !t ? SIZE_MAX : t->length;
+}
+
+char table__push_row(const Table t, const void *const *row) {
+    if (!t || !row) return FAILURE;
+
+    if (t->length == t->capacity && table_resize(t, t->capacity<<1) < 0) return FAILURE;
+
+    for (size_t c = 0; c < t->n_columns; c++) {
+        memcpy(CELL(t, c, t->length), row[c], t->sizes[c]);
+    }
+    t->length++;
+
+    return SUCCESS;
+}
+
+char table__pop_row(const Table t, void *const *row) {
+    size_t new_capacity;
+    if (!t || !t->length) return FAILURE;
+
+    t->length--;
+    if (row) {
+        for (size_t c = 0; c < t->n_columns; c++) {
+            memcpy(row[c], CELL(t, c, t->length), t->sizes[c]);
+        }
+    }
+
+    new_capacity = t->capacity>>1;
+    if (t->length < new_capacity>>1 && new_capacity >= DEFAULT_TABLE_CAPACITY) {
+        table_resize(t, new_capacity);
+    }
+
+    return SUCCESS;
+}
+
+char table__get(const Table t, const size_t i, const size_t column, void *value) {
+    if (!t || !value || i >= t->length || column >= t->n_columns) return FAILURE;
+
+    memcpy(value, CELL(t, column, i), t->sizes[column]);
+
+    return SUCCESS;
+}
+
+const void *table__column(const Table t, const size_t column) {
+    if (!t || column >= t->n_columns) return NULL;
+
+    return t->columns[column];
+}
+
+size_t table__filter_column(const Table t, const size_t column, const filter_func_t pred, void *user_data, size_t *rows) {
+    if (!t || !pred || !rows || column >= t->n_columns) return SIZE_MAX;
+
+    const char *values = t->columns[column];
+    const size_t size = t->sizes[column];
+    size_t k = 0;
+
+    for (size_t i = 0; i < t->length; i++) {
+        rows[k] = i;
+        k += pred(values + size * i, user_data) ? 1 : 0;
+    }
+
+    return k;
+}
+
+size_t table__filter_range_u64(const Table t, const size_t column, const uint64_t lo, const uint64_t hi, size_t *rows) {
+    if (!t || !rows || column >= t->n_columns || t->sizes[column] != sizeof(uint64_t)) return SIZE_MAX;
+    if (lo > hi) return 0;
+
+    const uint64_t *values = (const uint64_t *)(void *)t->columns[column];
+    const uint64_t width = hi - lo;
+    size_t k = 0;
+
+    for (size_t i = 0; i < t->length; i++) {
+        rows[k] = i;
+        k += values[i] - lo <= width;
+    }
+
+    return k;
+}
+
+char table__sort_by_column(const Table t, const size_t column, const compare_func_t cmp, size_t *perm) {
+    if (!t || !cmp || !perm || column >= t->n_columns) return FAILURE;
+
+    for (size_t i = 0; i < t->length; i++) {
+        perm[i] = i;
+    }
+    if (t->length < 2) return SUCCESS;
+
+    size_t *tmp = malloc(sizeof(size_t) * t->length);
+    if (!tmp) return FAILURE;
+
+    rows_sort(t, column, cmp, perm, tmp, 0, t->length);
+
+    free(tmp);
+    return SUCCESS;
+}
+
+char table__permute(const Table t, const size_t *perm) {
+    if (!t || !perm) return FAILURE;
+    if (t->length < 2) return SUCCESS;
+
+    size_t max_size = 0;
+    for (size_t c = 0; c < t->n_columns; c++) {
+        if (t->sizes[c] > max_size) max_size = t->sizes[c];
+    }
+
+    char *buffer = malloc(max_size * t->length);
+    if (!buffer) return FAILURE;
+
+    for (size_t c = 0; c < t->n_columns; c++) {
+        for (size_t k = 0; k < t->length; k++) {
+            memcpy(buffer + t->sizes[c] * k, CELL(t, c, perm[k]), t->sizes[c]);
+        }
+        memcpy(t->columns[c], buffer, t->sizes[c] * t->length);
+    }
+
+    free(buffer);
+    return SUCCESS;
+}
+
+void table__clear(const Table t) {
+    if (!t) return;
+
+    t->length = 0;
+    table_resize(t, DEFAULT_TABLE_CAPACITY);
+}
+
+void table__free(const Table t) {
+    if (!t) return;
+
+    if (t->columns) {
+        for (size_t c = 0; c < t->n_columns; c++) {
+            free(t->columns[c]);
+        }
+    }
+
+    free(t->columns);
+    free(t->sizes);
+    free(t);
+}
@@ -0,0 +1,165 @@
+#ifndef __TABLE_H__
+#define __TABLE_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a multi-column table stored as a structure of arrays
+ *
+ * Notes :
+ * 1) Each column is a contiguous array of fixed-size values, the byte size of every column is given at creation.
+ * Rows are pushed and popped as a whole, their values are copied byte-wise into the columns:
+ * a row is described by an array holding one pointer to the value of each column.
+ *
+ * 2) Functions working on a single column only touch the memory of this column, which makes scans
+ * of one field independent of the width of the rows.
+ *
+ * 3) Values are plain bytes, the table never calls any copy or delete operator.
+ */
+typedef struct TableSt * Table;
+
+
+/**
+ * @brief create an empty table
+ * @note complexity: O(c) where c is the number of columns
+ * @param n_columns number of columns
+ * @param column_sizes byte size of the values of each column
+ * @return a pointer to table on success, NULL on failure
+ */
+Table table__empty(const size_t n_columns, const size_t *column_sizes);
+
+
+/**
+ * @brief checks if the table is empty
+ * @note complexity: O(1)
+ * @param t the table
+ * @return 1 if the table is empty, 0 if not, -1 on failure
+ */
+char table__is_empty(const Table t);
+
+
+/**
+ * @brief number of rows in the table
+ * @note complexity: O(1)
+ * @param t the table
+ * @return the number of rows contained in the table on success, SIZE_MAX on failure
+ */
+size_t table__length(const Table t);
+
+
+/**
+ * @brief adds a row at the end of the table
+ * @note complexity: O(c) where c is the number of columns
+ * @param t the table
+ * @param row array holding a pointer to the value of each column
+ * @return 0 on success, -1 on failure
+ */
+char table__push_row(const Table t, const void *const *row);
+
+
+/**
+ * @brief removes the last row of the table
+ * @details if 'row' is not NULL the values of the removed row are copied into the buffers it points to
+ * @note complexity: O(c) where c is the number of columns
+ * @param t the table
+ * @param row array holding a pointer to the storage buffer of each column, can be NULL
+ * @return 0 on success, -1 on failure
+ */
+char table__pop_row(const Table t, void *const *row);
+
+
+/**
+ * @brief copies the value at the given row and column
+ * @note complexity: O(1)
+ * @param t the table
+ * @param i row
+ * @param column column
+ * @param value storage buffer, must hold the byte size of the column
+ * @return 0 on success, -1 on failure
+ */
+char table__get(const Table t, const size_t i, const size_t column, void *value);
+
+
+/**
+ * @brief retrieves the contiguous array of values of a column
+ * @details the pointer is invalidated by any function adding or removing rows
+ * @note complexity: O(1)
+ * @param t the table
+ * @param column column
+ * @return a pointer to the first value of the column on success, NULL on failure
+ */
+const void *table__column(const Table t, const size_t column);
+
+
+/**
+ * @brief retrieves the rows whose value in the given column satisfies the predicate
+ * @details 'pred' receives a pointer to the value of the column
+ * @note complexity: O(n)
+ * @param t the table
+ * @param column column
+ * @param pred the predicate
+ * @param user_data optional data to be used as an additional argument of the predicate
+ * @param rows storage array of matching rows in ascending order, must hold the length of the table
+ * @return the number of matching rows on success, SIZE_MAX on failure
+ */
+size_t table__filter_column(const Table t, const size_t column, const filter_func_t pred, void *user_data, size_t *rows);
+
+
+/**
+ * @brief retrieves the rows whose value in the given column is in [lo, hi]
+ * @details the column must hold 8 bytes unsigned integers, the scan is branchless
+ * @note complexity: O(n)
+ * @param t the table
+ * @param column column
+ * @param lo lower bound
+ * @param hi upper bound
+ * @param rows storage array of matching rows in ascending order, must hold the length of the table
+ * @return the number of matching rows on success, SIZE_MAX on failure
+ */
+size_t table__filter_range_u64(const Table t, const size_t column, const uint64_t lo, const uint64_t hi, size_t *rows);
+
+
+/**
+ * @brief computes the permutation sorting the rows by the values of a column
+ * @details 'cmp' receives pointers to values of the column, the sort is stable. The table is left unaltered
+ * @note complexity: O(n*log(n))
+ * @param t the table
+ * @param column column
+ * @param cmp the compare function
+ * @param perm storage array, perm[k] is the row at position k once sorted, must hold the length of the table
+ * @return 0 on success, -1 on failure
+ */
+char table__sort_by_column(const Table t, const size_t column, const compare_func_t cmp, size_t *perm);
+
+
+/**
+ * @brief reorders the rows of the table following a permutation
+ * @details row perm[k] of the table becomes row k
+ * @note complexity: O(n*c) where c is the number of columns
+ * @param t the table
+ * @param perm permutation of the rows, must hold the length of the table
+ * @return 0 on success, -1 on failure
+ */
+char table__permute(const Table t, const size_t *perm);
+
+
+/**
+ * @brief removes all rows in the table
+ * @note complexity: O(c) where c is the number of columns
+ * @param t the table
+ */
+void table__clear(const Table t);
+
+
+/**
+ * @brief frees all allocated memory used by the table
+ * @note complexity: O(c) where c is the number of columns
+ * @param t the table
+ */
+void table__free(const Table t);
+
+
+#endif
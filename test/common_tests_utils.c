@@ -42,6 +42,15 @@ void operator_delete(void *p_value) {
     free(p_value);
 }
 
+u32 delete_counts[COUNTED_VALUES];
+
+void operator_delete_counted(void *p_value) {
+    if (p_value && *(u32 *)p_value < COUNTED_VALUES) {
+        delete_counts[*(u32 *)p_value]++;
+    }
+    free(p_value);
+}
+
 int operator_compare(const void *v1, const void *v2) {
     if (v1 == NULL || v2 == NULL) {
         printf("NULL value compared");
@@ -97,4 +106,19 @@ void *bin_plus_op(const void *a, const void *b, void *user_data) {
 
 char predicate(const void *v, void *user_data) {
     return *(u32*)v % *(u32*)user_data == 0;
-}
\ No newline at end of file
+}
+
+uint64_t operator_key(const void *v) {
+    return *(u32 *)v;
+}
+
+void operator_extract_key(const void *v, void *key) {
+    *(u32 *)key = *(u32 *)v;
+}
+
+int operator_key_compare(const void *k1, const void *k2) {
+    u32 arg1 = *(u32 *)k1;
+    u32 arg2 = *(u32 *)k2;
+
+    return (arg1 > arg2) - (arg1 < arg2);
+}
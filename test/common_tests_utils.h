@@ -2,6 +2,7 @@
 #define __COMMON_TESTS_UTILS_H__
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -114,6 +115,12 @@
 
 typedef unsigned int u32;
 
+/**
+ * Number of times every value in [0, COUNTED_VALUES) was deleted by 'operator_delete_counted'
+ */
+#define COUNTED_VALUES 16
+extern u32 delete_counts[COUNTED_VALUES];
+
 ///////////////////////////////////////////////////////////////////////////////
 ///     COMMON TESTS FUNCTIONS
 ///////////////////////////////////////////////////////////////////////////////
@@ -139,6 +146,7 @@ void print_test_summary(int nb_success, int nb_tests);
 
 void *operator_copy(void *p_value);
 void operator_delete(void *p_value);
+void operator_delete_counted(void *p_value);
 int operator_compare(const void *v1, const void *v2);
 int operator_match(const void *v1, const void *v2);
 void operator_debug_i32(const int *p_value);
@@ -147,5 +155,8 @@ void operator_debug_char(const char *p_value);
 void plus_op(const void *a, void *user_data);
 void *bin_plus_op(const void *a, const void *b, void *user_data);
 char predicate(const void *v, void *user_data);
+uint64_t operator_key(const void *v);
+void operator_extract_key(const void *v, void *key);
+int operator_key_compare(const void *k1, const void *k2);
 
 #endif
@@ -0,0 +1,214 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common_tests_utils.h"
+#include "../common/defs.h"
+#include "../common/alloc.h"
+#include "../common/vec.h"
+
+/**
+ * Built with -DELEMS_ALIGNMENT=64, the checks fall back to the alignment of an element otherwise
+ */
+#if ELEMS_ALIGNMENT > 0
+#define ALIGNMENT ELEMS_ALIGNMENT
+#else
+#define ALIGNMENT sizeof(elem_t)
+#endif
+
+#define IS_ALIGNED(__block, __alignment) \
+    ((uintptr_t)(__block) % (__alignment) == 0)
+
+#define VALUE(__i) \
+    ((elem_t)(uintptr_t)((__i) + 1))
+
+/**
+ * Smallest structure handled by the resize macros of vec.h, as the vector based ADTs use them
+ */
+typedef struct
+{
+    elem_t *elems;
+    size_t back;
+    size_t length;
+    size_t capacity;
+    elem_t *old_elems;
+    size_t old_shift;
+    size_t old_end;
+    size_t migrated;
+} Buffer;
+
+static Buffer *buffer__empty(const size_t capacity) {
+    Buffer *b = calloc(1, sizeof(Buffer));
+    if (!b) return NULL;
+
+    if (!(b->elems = alloc__elems(capacity))) {
+        free(b);
+        return NULL;
+    }
+    b->capacity = capacity;
+
+    return b;
+}
+
+static void buffer__free(Buffer *b) {
+    free(b->old_elems);
+    free(b->elems);
+    free(b);
+}
+
+static bool buffer__holds(const Buffer *b, const size_t front, const size_t n) {
+    bool result = IS_ALIGNED(b->elems, ALIGNMENT) && b->back - front == n;
+    for (size_t i = 0; i < n; i++) {
+        result &= b->elems[front + i] == VALUE(i);
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_alloc__elems(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    size_t sizes[4] = {0, 1, 3, 1000};
+    elem_t *elems;
+    void *control;
+
+    for (u32 i = 0; i < 4; i++) {
+        elems = alloc__elems(sizes[i]);
+        result &= elems != NULL && IS_ALIGNED(elems, ALIGNMENT);
+        free(elems);
+    }
+
+    control = alloc__control(2 * CACHE_LINE_SIZE);
+#if ELEMS_ALIGNMENT > 0
+    result &= control != NULL && IS_ALIGNED(control, CACHE_LINE_SIZE);
+#else
+    result &= control != NULL;
+#endif
+    free(control);
+
+    return result;
+}
+
+static bool test_alloc__resize_elems(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    size_t sizes[5] = {4, 1000, 1001, 3, 64};
+    size_t capacity = 0;
+    elem_t *elems = alloc__resize_elems(NULL, 0, 2);
+
+    result &= elems != NULL && IS_ALIGNED(elems, ALIGNMENT);
+    capacity = 2;
+    elems[0] = VALUE(0);
+    elems[1] = VALUE(1);
+
+    for (u32 k = 0; k < 5; k++) {
+        elem_t *res = alloc__resize_elems(elems, capacity, sizes[k]);
+        result &= res != NULL && IS_ALIGNED(res, ALIGNMENT);
+        if (!res) break;
+
+        for (size_t i = 0; i < capacity && i < sizes[k]; i++) {
+            result &= res[i] == VALUE(i);
+        }
+        for (size_t i = capacity; i < sizes[k]; i++) {
+            res[i] = VALUE(i);
+        }
+        elems = res;
+        capacity = sizes[k];
+    }
+
+    free(elems);
+    return result;
+}
+
+static bool test_alloc__vec_resize(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const size_t N = 1000;
+    size_t new_capacity;
+    Buffer *b = buffer__empty(2);
+
+    /* growth as in a push */
+    for (size_t i = 0; i < N; i++) {
+        result &= !ENSURE_CAPACITY(b);
+        b->elems[b->back++] = VALUE(i);
+        b->length++;
+        result &= IS_ALIGNED(b->elems, ALIGNMENT);
+    }
+    result &= buffer__holds(b, 0, N);
+
+    /* shrink as in a pop */
+    while (b->back > 10) {
+        b->back--;
+        b->length--;
+        new_capacity = b->capacity>>1;
+        if (b->length < new_capacity) {
+            result &= !RESIZE(b, new_capacity);
+        }
+        result &= IS_ALIGNED(b->elems, ALIGNMENT);
+    }
+    result &= buffer__holds(b, 0, 10) && b->capacity <= 4 * 10;
+
+    /* room made before the front */
+    size_t front = RECENTER(b, 0);
+    result &= front != SIZE_MAX && front > 0 && buffer__holds(b, front, 10);
+
+    buffer__free(b);
+    return result;
+}
+
+static bool test_alloc__vec_rebase(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const size_t N = 1000;
+    Buffer *b = buffer__empty(0);
+
+    /* incremental growth, from an empty buffer */
+    for (size_t i = 0; i < N; i++) {
+        if (b->back == b->capacity) {
+            result &= !INCREMENTAL_GROW(b, 0, 2);
+        }
+        SLOT(b, b->back) = VALUE(i);
+        b->back++;
+        b->length++;
+        MIGRATE(b, 0, MIGRATE_STEP);
+        result &= IS_ALIGNED(b->elems, ALIGNMENT);
+    }
+    MIGRATE_ALL(b, 0);
+    result &= b->old_elems == NULL && buffer__holds(b, 0, N);
+
+    size_t front = INCREMENTAL_RECENTER(b, 0, 2);
+    result &= front != SIZE_MAX && front > 0;
+    MIGRATE_ALL(b, front);
+    result &= buffer__holds(b, front, N);
+
+    buffer__free(b);
+    return result;
+}
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST ALLOC -----------\n");
+
+    print_test_result(test_alloc__elems(), &nb_success, &nb_tests);
+    print_test_result(test_alloc__resize_elems(), &nb_success, &nb_tests);
+    print_test_result(test_alloc__vec_resize(), &nb_success, &nb_tests);
+    print_test_result(test_alloc__vec_rebase(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
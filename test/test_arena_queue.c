@@ -0,0 +1,126 @@
+#include "common_tests_utils.h"
+#include "../arena_queue/arena_queue.h"
+#include "../common/defs.h"
+
+#define ARENA_SIZE 512
+
+#define TEST_ON_ARENA_QUEUE(__name, __rand, __expr) \
+static bool __name(char debug) \
+{ \
+    printf("%s... ", __func__); \
+    bool result = TEST_SUCCESS; \
+    u32 *arena = malloc(sizeof(u32) * ARENA_SIZE); \
+    for (u32 i = 0; i < ARENA_SIZE; i++) { \
+        arena[i] = __rand ? (u32)rand() % 50 : i; \
+    } \
+    ArenaQueue q = arena_queue__empty(arena, sizeof(u32) * ARENA_SIZE); \
+    for (u32 i = 0; i < ARENA_SIZE; i++) { \
+        result &= !arena_queue__enqueue(q, arena + i); \
+    } \
+    if (debug) arena_queue__debug(q, (void (*)(elem_t))operator_debug_u32); \
+    __expr \
+    arena_queue__free(q); \
+    free(arena); \
+    return result; \
+}
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_arena_queue__empty(void)
+{
+    printf("%s... ", __func__);
+
+    u32 arena[4];
+    ArenaQueue q = arena_queue__empty(arena, sizeof(arena));
+    bool result = (q && arena_queue__is_empty(q) == 1 && arena_queue__length(q) == 0
+                && !arena_queue__empty(NULL, 4)) ? TEST_SUCCESS : TEST_FAILURE;
+
+    arena_queue__free(q);
+    return result;
+}
+
+TEST_ON_ARENA_QUEUE (
+    test_arena_queue__enqueue_outside_arena, false,
+    u32 outside = 0;
+    result &= arena_queue__enqueue(q, &outside) == -1;
+    result &= arena_queue__enqueue(q, arena + ARENA_SIZE) == -1;
+    result &= !arena_queue__enqueue(q, NULL);
+    result &= arena_queue__length(q) == ARENA_SIZE + 1;
+)
+
+TEST_ON_ARENA_QUEUE (
+    test_arena_queue__dequeue_and_peek, false,
+    elem_t e = NULL;
+    for (u32 i = 0; i < ARENA_SIZE; i++) {
+        result &= !arena_queue__peek_nth(q, ARENA_SIZE - i - 1, &e) && e == arena + ARENA_SIZE - 1;
+        result &= !arena_queue__dequeue(q, &e) && e == arena + i;
+        result &= arena_queue__length(q) == ARENA_SIZE - i - 1;
+    }
+    result &= arena_queue__dequeue(q, &e) == -1 && arena_queue__is_empty(q) == 1;
+)
+
+TEST_ON_ARENA_QUEUE (
+    test_arena_queue__search_and_contains, false,
+    u32 value = 7;
+    result &= arena_queue__search(q, &value, operator_match) == 7;
+    result &= arena_queue__ptr_search(q, arena + 42) == 42;
+    result &= arena_queue__contains(q, &value, operator_match) == 1;
+    arena_queue__dequeue(q, NULL);
+    result &= arena_queue__ptr_search(q, arena + 42) == 41;
+    result &= arena_queue__ptr_search(q, &value) == SIZE_MAX;
+    value = ARENA_SIZE;
+    result &= arena_queue__contains(q, &value, operator_match) == 0;
+)
+
+TEST_ON_ARENA_QUEUE (
+    test_arena_queue__foreach_and_to_array, false,
+    u32 value = 1;
+    arena_queue__foreach(q, plus_op, &value);
+    elem_t *A = arena_queue__to_array(q);
+    for (u32 i = 0; i < ARENA_SIZE; i++) {
+        result &= A[i] == arena + i && arena[i] == i + 1;
+    }
+    free(A);
+)
+
+TEST_ON_ARENA_QUEUE (
+    test_arena_queue__sort, true,
+    elem_t a;
+    elem_t b;
+    arena_queue__dequeue(q, NULL);
+    arena_queue__sort(q, operator_compare);
+    result &= arena_queue__length(q) == ARENA_SIZE - 1;
+    for (u32 i = 0; i + 1 < ARENA_SIZE - 1; i++) {
+        arena_queue__peek_nth(q, i, &a);
+        arena_queue__peek_nth(q, i + 1, &b);
+        result &= *(u32 *)a <= *(u32 *)b;
+    }
+)
+
+TEST_ON_ARENA_QUEUE (
+    test_arena_queue__clear, true,
+    arena_queue__clear(q);
+    result &= arena_queue__is_empty(q) == 1 && !arena_queue__enqueue(q, arena);
+)
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST ARENA QUEUE -----------\n");
+
+    print_test_result(test_arena_queue__empty(), &nb_success, &nb_tests);
+    print_test_result(test_arena_queue__enqueue_outside_arena(false), &nb_success, &nb_tests);
+    print_test_result(test_arena_queue__dequeue_and_peek(false), &nb_success, &nb_tests);
+    print_test_result(test_arena_queue__search_and_contains(false), &nb_success, &nb_tests);
+    print_test_result(test_arena_queue__foreach_and_to_array(false), &nb_success, &nb_tests);
+    print_test_result(test_arena_queue__sort(false), &nb_success, &nb_tests);
+    print_test_result(test_arena_queue__clear(false), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
@@ -0,0 +1,189 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <string.h>
+#include <unistd.h>
+
+#include "common_tests_utils.h"
+#include "../byte_chain/byte_chain.h"
+#include "../common/defs.h"
+
+////////////////////////////////////////////////////////////////////
+///     TEST UTILITARIES
+////////////////////////////////////////////////////////////////////
+
+static void fill_pattern(unsigned char *bytes, const size_t n, const size_t offset) {
+    for (size_t i = 0; i < n; i++) {
+        bytes[i] = (unsigned char)((i + offset) * 7);
+    }
+}
+
+static bool check_pattern(const unsigned char *bytes, const size_t n, const size_t offset) {
+    for (size_t i = 0; i < n; i++) {
+        if (bytes[i] != (unsigned char)((i + offset) * 7)) return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_byte_chain__empty(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    struct iovec iov[4];
+    unsigned char byte;
+    ByteChain c = byte_chain__empty(16, 4);
+
+    result &= c && byte_chain__length(c) == 0 && byte_chain__empty(0, 4) == NULL;
+    result &= byte_chain__consume(c, 0) == 0 && byte_chain__consume(c, 1) == -1;
+    result &= byte_chain__copy(c, &byte, 1) == 0 && byte_chain__peek_contiguous(c, 1) == NULL;
+    result &= byte_chain__data_iovecs(c, iov, 4) == 0 && byte_chain__commit(c, 1) == -1;
+    result &= byte_chain__length(NULL) == SIZE_MAX && byte_chain__append(NULL, &byte, 1) == -1;
+    result &= byte_chain__append(c, NULL, 1) == -1 && byte_chain__writev(NULL, 0) == -1;
+
+    byte_chain__free(c);
+    byte_chain__free(NULL);
+    return result;
+}
+
+static bool test_byte_chain__append_consume(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    unsigned char in[100], out[100];
+    ByteChain c = byte_chain__empty(16, 4);
+
+    fill_pattern(in, 100, 0);
+    result &= !byte_chain__append(c, in, 10) && !byte_chain__append(c, in + 10, 90);
+    result &= byte_chain__length(c) == 100;
+    result &= byte_chain__copy(c, out, 100) == 100 && check_pattern(out, 100, 0);
+
+    result &= !byte_chain__consume(c, 37) && byte_chain__length(c) == 63;
+    result &= byte_chain__copy(c, out, 100) == 63 && check_pattern(out, 63, 37);
+
+    result &= !byte_chain__append(c, in, 20) && byte_chain__length(c) == 83;
+    result &= byte_chain__copy(c, out, 83) == 83 && check_pattern(out, 63, 37) && check_pattern(out + 63, 20, 0);
+
+    result &= !byte_chain__consume(c, 83) && byte_chain__length(c) == 0;
+    result &= !byte_chain__append(c, in, 5) && byte_chain__copy(c, out, 5) == 5 && check_pattern(out, 5, 0);
+
+    byte_chain__free(c);
+    return result;
+}
+
+static bool test_byte_chain__peek_contiguous(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    unsigned char in[64], out[64];
+    const unsigned char *bytes;
+    ByteChain c = byte_chain__empty(16, 0);
+
+    fill_pattern(in, 64, 0);
+    byte_chain__append(c, in, 40);
+
+    result &= (bytes = byte_chain__peek_contiguous(c, 10)) && check_pattern(bytes, 10, 0);
+    result &= !byte_chain__consume(c, 12);
+    result &= (bytes = byte_chain__peek_contiguous(c, 16)) && check_pattern(bytes, 16, 12);
+    result &= byte_chain__peek_contiguous(c, 17) == NULL && byte_chain__peek_contiguous(c, 0) == NULL;
+
+    result &= !byte_chain__consume(c, 20) && byte_chain__length(c) == 8;
+    result &= (bytes = byte_chain__peek_contiguous(c, 8)) && check_pattern(bytes, 8, 32);
+    result &= byte_chain__peek_contiguous(c, 9) == NULL;
+
+    result &= !byte_chain__append(c, in + 40, 24) && byte_chain__length(c) == 32;
+    result &= (bytes = byte_chain__peek_contiguous(c, 16)) && check_pattern(bytes, 16, 32);
+    result &= byte_chain__copy(c, out, 64) == 32 && check_pattern(out, 32, 32);
+
+    byte_chain__free(c);
+    return result;
+}
+
+static bool test_byte_chain__iovecs(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    unsigned char in[200], out[200];
+    struct iovec iov[8];
+    size_t count, total = 0;
+    int fds[2];
+    ByteChain c = byte_chain__empty(32, 2);
+    ByteChain d = byte_chain__empty(24, 2);
+
+    fill_pattern(in, 200, 0);
+    result &= !pipe(fds);
+
+    count = byte_chain__space_iovecs(c, 70, iov, 8);
+    result &= count == 3 && iov[0].iov_len == 32 && byte_chain__length(c) == 0;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(iov[i].iov_base, in + total, iov[i].iov_len);
+        total += iov[i].iov_len;
+    }
+    result &= !byte_chain__commit(c, 70) && byte_chain__length(c) == 70;
+    result &= !byte_chain__append(c, in + 70, 130) && byte_chain__length(c) == 200;
+
+    count = byte_chain__data_iovecs(c, iov, 8);
+    result &= count == 7 && iov[0].iov_len == 32 && iov[6].iov_len == 8;
+    result &= byte_chain__data_iovecs(c, iov, 2) == 2;
+
+    result &= byte_chain__writev(c, fds[1]) == 200 && byte_chain__length(c) == 0;
+    result &= byte_chain__readv(d, fds[0], 150) == 150 && byte_chain__length(d) == 150;
+    result &= byte_chain__readv(d, fds[0], 100) == 50 && byte_chain__length(d) == 200;
+    result &= byte_chain__copy(d, out, 200) == 200 && check_pattern(out, 200, 0);
+
+    close(fds[0]);
+    close(fds[1]);
+    byte_chain__free(c);
+    byte_chain__free(d);
+    return result;
+}
+
+static bool test_byte_chain__clear(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    unsigned char in[256], out[256];
+    ByteChain c = byte_chain__empty(8, 64);
+
+    fill_pattern(in, 256, 0);
+
+    for (size_t round = 0; round < 50; round++) {
+        result &= !byte_chain__append(c, in, 256);
+        result &= !byte_chain__consume(c, 100) && byte_chain__copy(c, out, 256) == 156 && check_pattern(out, 156, 100);
+        if (round % 2) {
+            byte_chain__clear(c);
+        } else {
+            result &= !byte_chain__consume(c, 156);
+        }
+        result &= byte_chain__length(c) == 0;
+    }
+
+    byte_chain__clear(NULL);
+    byte_chain__free(c);
+    return result;
+}
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST BYTE CHAIN -----------\n");
+
+    print_test_result(test_byte_chain__empty(), &nb_success, &nb_tests);
+    print_test_result(test_byte_chain__append_consume(), &nb_success, &nb_tests);
+    print_test_result(test_byte_chain__peek_contiguous(), &nb_success, &nb_tests);
+    print_test_result(test_byte_chain__iovecs(), &nb_success, &nb_tests);
+    print_test_result(test_byte_chain__clear(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
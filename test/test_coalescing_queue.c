@@ -0,0 +1,191 @@
+#include "common_tests_utils.h"
+#include "../coalescing_queue/coalescing_queue.h"
+#include "../common/defs.h"
+
+#define COALESCING_QUEUE_CREATE(A, MERGE) \
+    CoalescingQueue A = coalescing_queue__empty(operator_key, operator_match, MERGE, NULL, operator_delete)
+
+////////////////////////////////////////////////////////////////////
+///     TEST OPERATORS
+////////////////////////////////////////////////////////////////////
+
+/**
+ * Update of a key, the key is the first field so that the u32 operators apply
+ */
+typedef struct
+{
+    u32 key;
+    u32 count;
+} Update;
+
+static Update *new_update(const u32 key) {
+    Update *u = malloc(sizeof(Update));
+    u->key = key;
+    u->count = 1;
+    return u;
+}
+
+static void *merge_updates(const void *pending, const void *update, void *user_data) {
+    ((Update *)pending)->count += ((const Update *)update)->count;
+    return (void *)pending;
+}
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_coalescing_queue__empty(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    elem_t elem;
+    u32 key = 0;
+    COALESCING_QUEUE_CREATE(q, NULL);
+
+    result &= q && coalescing_queue__is_empty(q) && coalescing_queue__length(q) == 0;
+    result &= coalescing_queue__empty(NULL, operator_match, NULL, NULL, NULL) == NULL;
+    result &= coalescing_queue__dequeue(q, &elem) == -1 && coalescing_queue__peek(q, &elem) == -1;
+    result &= coalescing_queue__find(q, &key, &elem) == -1 && coalescing_queue__enqueue(q, NULL) == -1;
+    result &= coalescing_queue__is_empty(NULL) == -1 && coalescing_queue__length(NULL) == SIZE_MAX;
+
+    coalescing_queue__free(q);
+    coalescing_queue__free(NULL);
+    return result;
+}
+
+static bool test_coalescing_queue__fifo(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 100;
+    elem_t elem;
+    COALESCING_QUEUE_CREATE(q, NULL);
+
+    for (u32 i = 0; i < N; i++) {
+        result &= !coalescing_queue__enqueue(q, new_update(i));
+        if (i % 3 == 2) {
+            result &= !coalescing_queue__dequeue(q, &elem) && ((Update *)elem)->key == i / 3;
+            free(elem);
+        }
+    }
+    result &= coalescing_queue__length(q) == N - N / 3;
+
+    for (u32 i = N / 3; i < N; i++) {
+        result &= !coalescing_queue__peek(q, &elem) && ((Update *)elem)->key == i;
+        result &= !coalescing_queue__dequeue(q, &elem) && ((Update *)elem)->key == i;
+        free(elem);
+    }
+    result &= coalescing_queue__is_empty(q);
+
+    coalescing_queue__free(q);
+    return result;
+}
+
+static bool test_coalescing_queue__replace(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    Update *last;
+    elem_t elem;
+    u32 key = 1;
+    COALESCING_QUEUE_CREATE(q, NULL);
+
+    coalescing_queue__enqueue(q, new_update(1));
+    coalescing_queue__enqueue(q, new_update(2));
+    last = new_update(1);
+    last->count = 7;
+    result &= !coalescing_queue__enqueue(q, last);
+    result &= coalescing_queue__length(q) == 2;
+    result &= !coalescing_queue__find(q, &key, &elem) && elem == last;
+
+    result &= !coalescing_queue__dequeue(q, &elem) && elem == last;
+    free(elem);
+    result &= coalescing_queue__find(q, &key, &elem) == -1;
+
+    coalescing_queue__enqueue(q, new_update(1));
+    result &= !coalescing_queue__dequeue(q, NULL) && !coalescing_queue__peek(q, &elem) && ((Update *)elem)->key == 1;
+
+    coalescing_queue__free(q);
+    return result;
+}
+
+static bool test_coalescing_queue__merge(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 keys[5] = {3, 1, 3, 3, 1};
+    elem_t elem;
+    COALESCING_QUEUE_CREATE(q, merge_updates);
+
+    for (u32 i = 0; i < 5; i++) {
+        result &= !coalescing_queue__enqueue(q, new_update(keys[i]));
+    }
+    result &= coalescing_queue__length(q) == 2;
+
+    result &= !coalescing_queue__dequeue(q, &elem);
+    result &= ((Update *)elem)->key == 3 && ((Update *)elem)->count == 3;
+    free(elem);
+    result &= !coalescing_queue__dequeue(q, &elem);
+    result &= ((Update *)elem)->key == 1 && ((Update *)elem)->count == 2;
+    free(elem);
+
+    coalescing_queue__free(q);
+    return result;
+}
+
+static bool test_coalescing_queue__storm(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 100000;
+    const u32 KEYS = 64;
+    u32 total = 0, previous = 0;
+    elem_t elem;
+    COALESCING_QUEUE_CREATE(q, merge_updates);
+
+    srand(13);
+    for (u32 i = 0; i < N; i++) {
+        result &= !coalescing_queue__enqueue(q, new_update(i < KEYS ? i : (u32)rand() % KEYS));
+        if (i % 1000 == 999) {
+            result &= coalescing_queue__length(q) <= KEYS;
+        }
+    }
+    result &= coalescing_queue__length(q) == KEYS;
+
+    while (!coalescing_queue__dequeue(q, &elem)) {
+        result &= ((Update *)elem)->key == previous++;
+        total += ((Update *)elem)->count;
+        free(elem);
+    }
+    result &= total == N;
+
+    coalescing_queue__enqueue(q, new_update(0));
+    coalescing_queue__clear(q);
+    result &= coalescing_queue__is_empty(q);
+
+    coalescing_queue__free(q);
+    return result;
+}
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST COALESCING QUEUE -----------\n");
+
+    print_test_result(test_coalescing_queue__empty(), &nb_success, &nb_tests);
+    print_test_result(test_coalescing_queue__fifo(), &nb_success, &nb_tests);
+    print_test_result(test_coalescing_queue__replace(), &nb_success, &nb_tests);
+    print_test_result(test_coalescing_queue__merge(), &nb_success, &nb_tests);
+    print_test_result(test_coalescing_queue__storm(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
@@ -0,0 +1,185 @@
+#include "common_tests_utils.h"
+#include "../external_sort/external_sort.h"
+#include "../queue/queue.h"
+#include "../common/defs.h"
+
+#define EXTERNAL_SORT_CREATE(A, RUN_LENGTH) \
+    ExternalSort A = external_sort__empty(RUN_LENGTH, operator_compare, operator_serialize, operator_deserialize, operator_delete)
+
+////////////////////////////////////////////////////////////////////
+///     TEST OPERATORS
+////////////////////////////////////////////////////////////////////
+
+static char operator_serialize(const void *v, FILE *file) {
+    return fwrite(v, sizeof(u32), 1, file) == 1 ? 0 : -1;
+}
+
+static elem_t operator_deserialize(FILE *file) {
+    u32 *v = malloc(sizeof(u32));
+    if (v && fread(v, sizeof(u32), 1, file) == 1) return v;
+
+    free(v);
+    return NULL;
+}
+
+static void check_order(const void *v, void *user_data) {
+    u32 *state = user_data;
+    state[0] &= !state[1] || *(u32 *)v >= state[2];
+    state[1]++;
+    state[2] = *(u32 *)v;
+}
+
+static char push_random(const ExternalSort es, const u32 n) {
+    char res = 0;
+    for (u32 i = 0; i < n; i++) {
+        u32 *v = malloc(sizeof(u32));
+        *v = (u32)rand() % 1000;
+        res |= external_sort__push(es, v);
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_external_sort__empty(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 state[3] = {1, 0, 0};
+    EXTERNAL_SORT_CREATE(es, 16);
+
+    result &= es && external_sort__length(es) == 0 && external_sort__n_runs(es) == 0;
+    result &= external_sort__empty(0, operator_compare, operator_serialize, operator_deserialize, operator_delete) == NULL;
+    result &= external_sort__length(NULL) == SIZE_MAX && external_sort__push(es, NULL) == -1;
+    result &= !external_sort__merge(es, check_order, state) && state[1] == 0;
+
+    external_sort__free(es);
+    return result;
+}
+
+static bool test_external_sort__in_memory(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 100;
+    elem_t elem;
+    EXTERNAL_SORT_CREATE(es, N);
+    Queue q = queue__empty_copy_disabled();
+
+    result &= !push_random(es, N);
+    result &= external_sort__length(es) == N && external_sort__n_runs(es) == 0;
+    result &= !external_sort__merge_into(es, q);
+    result &= external_sort__length(es) == 0 && queue__length(q) == N;
+    result &= IS_SORTED(queue__peek_nth, N, q, false);
+
+    while (!queue__dequeue(q, &elem)) {
+        free(elem);
+    }
+
+    external_sort__free(es);
+    queue__free(q);
+    return result;
+}
+
+static bool test_external_sort__runs(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 1000;
+    u32 state[3] = {1, 0, 0};
+    EXTERNAL_SORT_CREATE(es, 16);
+
+    result &= !push_random(es, N);
+    result &= external_sort__n_runs(es) == (N - 1) / 16;
+    result &= !external_sort__merge(es, check_order, state);
+    result &= state[0] && state[1] == N && external_sort__n_runs(es) == 0;
+
+    state[1] = 0;
+    result &= !push_random(es, 20) && !external_sort__merge(es, check_order, state) && state[0] && state[1] == 20;
+
+    external_sort__free(es);
+    return result;
+}
+
+static bool test_external_sort__multi_pass(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 2000;
+    u32 state[3] = {1, 0, 0};
+    EXTERNAL_SORT_CREATE(es, 4);
+
+    result &= !push_random(es, N);
+    result &= external_sort__n_runs(es) > 64;
+    result &= !external_sort__merge(es, check_order, state);
+    result &= state[0] && state[1] == N;
+
+    external_sort__free(es);
+    return result;
+}
+
+static bool test_external_sort__queues(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 300;
+    u32 elems[300];
+    EXTERNAL_SORT_CREATE(es, 32);
+    Queue q = queue__empty_copy_enabled(operator_copy, operator_delete);
+    Queue w = queue__empty_copy_enabled(operator_copy, operator_delete);
+
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = N - i - 1;
+        queue__enqueue(q, elems + i);
+    }
+
+    result &= !external_sort__push_queue(es, q);
+    result &= queue__is_empty(q) && external_sort__length(es) == N;
+    result &= !external_sort__merge_into(es, w);
+    result &= queue__length(w) == N && COMPARE3(queue__peek_nth, N, w, 0, true);
+    result &= external_sort__push_queue(NULL, q) == -1 && external_sort__merge_into(es, NULL) == -1;
+
+    external_sort__free(es);
+    queue__free(q);
+    queue__free(w);
+    return result;
+}
+
+static bool test_external_sort__free_pending(void)
+{
+    printf("%s... ", __func__);
+
+    EXTERNAL_SORT_CREATE(es, 8);
+
+    bool result = !push_random(es, 100) && external_sort__n_runs(es) > 0;
+
+    external_sort__free(es);
+    external_sort__free(NULL);
+    return result;
+}
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST EXTERNAL SORT -----------\n");
+
+    print_test_result(test_external_sort__empty(), &nb_success, &nb_tests);
+    print_test_result(test_external_sort__in_memory(), &nb_success, &nb_tests);
+    print_test_result(test_external_sort__runs(), &nb_success, &nb_tests);
+    print_test_result(test_external_sort__multi_pass(), &nb_success, &nb_tests);
+    print_test_result(test_external_sort__queues(), &nb_success, &nb_tests);
+    print_test_result(test_external_sort__free_pending(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
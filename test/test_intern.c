@@ -0,0 +1,151 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <string.h>
+
+#include "common_tests_utils.h"
+#include "../intern/intern.h"
+#include "../queue/queue.h"
+#include "../common/defs.h"
+
+#define N_THREADS 4
+#define N_KEYS 512
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_intern__empty(void)
+{
+    printf("%s... ", __func__);
+
+    InternTable t = intern__empty();
+    bool result = (t && intern__length(t) == 0 && intern__length(NULL) == SIZE_MAX) ? TEST_SUCCESS : TEST_FAILURE;
+
+    intern__free(t);
+    return result;
+}
+
+static bool test_intern__get_and_lookup(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    char host[] = "host.example.org";
+    char copy[] = "host.example.org";
+    InternTable t = intern__empty();
+
+    const char *a = intern__get(t, host);
+    const char *b = intern__get(t, copy);
+    const char *c = intern__get_n(t, "host.example.org:8080", 16);
+
+    result &= a && a == b && a == c && a != host && !strcmp(a, host);
+    result &= intern__lookup(t, copy) == a;
+    result &= intern__lookup(t, "tenant") == NULL;
+    result &= intern__get(t, "") != NULL && intern__get(t, "") == intern__lookup(t, "");
+    result &= intern__length(t) == 2;
+
+    intern__free(t);
+    return result;
+}
+
+static bool test_intern__many_keys(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    char buffer[32];
+    const char *keys[N_KEYS];
+    InternTable t = intern__empty();
+
+    for (u32 i = 0; i < N_KEYS; i++) {
+        snprintf(buffer, sizeof(buffer), "tenant-%u", i);
+        keys[i] = intern__get(t, buffer);
+        result &= keys[i] != NULL;
+    }
+    for (u32 i = 0; i < N_KEYS; i++) {
+        snprintf(buffer, sizeof(buffer), "tenant-%u", i);
+        result &= intern__get(t, buffer) == keys[i] && !strcmp(keys[i], buffer);
+    }
+    result &= intern__length(t) == N_KEYS;
+
+    intern__free(t);
+    return result;
+}
+
+static bool test_intern__with_queue(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    char buffer[32];
+    InternTable t = intern__empty();
+    Queue q = queue__empty_copy_disabled();
+
+    for (u32 i = 0; i < 16; i++) {
+        snprintf(buffer, sizeof(buffer), "host-%u", i % 4);
+        queue__enqueue(q, (elem_t)intern__get(t, buffer));
+    }
+
+    strcpy(buffer, "host-2");
+    result &= queue__ptr_contains(q, (elem_t)intern__get(t, buffer)) == 1;
+    result &= queue__ptr_search(q, (elem_t)intern__get(t, buffer)) == 2;
+    result &= queue__ptr_contains(q, buffer) == 0;
+    result &= intern__length(t) == 4;
+
+    queue__free(q);
+    intern__free(t);
+    return result;
+}
+
+static void *intern_worker(void *arg) {
+    InternTable t = arg;
+    char buffer[32];
+
+    for (u32 i = 0; i < N_KEYS; i++) {
+        snprintf(buffer, sizeof(buffer), "key-%u", i);
+        if (!intern__get(t, buffer) || intern__lookup(t, buffer) != intern__get(t, buffer)) return arg;
+    }
+
+    return NULL;
+}
+
+static bool test_intern__concurrent(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    pthread_t threads[N_THREADS];
+    void *res;
+    InternTable t = intern__empty();
+
+    for (u32 i = 0; i < N_THREADS; i++) {
+        pthread_create(threads + i, NULL, intern_worker, t);
+    }
+    for (u32 i = 0; i < N_THREADS; i++) {
+        pthread_join(threads[i], &res);
+        result &= res == NULL;
+    }
+    result &= intern__length(t) == N_KEYS;
+
+    intern__free(t);
+    return result;
+}
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST INTERN -----------\n");
+
+    print_test_result(test_intern__empty(), &nb_success, &nb_tests);
+    print_test_result(test_intern__get_and_lookup(), &nb_success, &nb_tests);
+    print_test_result(test_intern__many_keys(), &nb_success, &nb_tests);
+    print_test_result(test_intern__with_queue(), &nb_success, &nb_tests);
+    print_test_result(test_intern__concurrent(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
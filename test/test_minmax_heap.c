@@ -0,0 +1,208 @@
+#include "common_tests_utils.h"
+#include "../minmax_heap/minmax_heap.h"
+#include "../common/defs.h"
+
+////////////////////////////////////////////////////////////////////
+///     TEST OPERATORS
+////////////////////////////////////////////////////////////////////
+
+static int compare_values(const void *a, const void *b) {
+    u32 x = *(const u32 *)a;
+    u32 y = *(const u32 *)b;
+    return (x > y) - (x < y);
+}
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_minmax_heap__empty(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    elem_t elem;
+    MinMaxHeap h = minmax_heap__empty_copy_disabled(operator_compare);
+
+    result &= h && minmax_heap__is_empty(h) && minmax_heap__length(h) == 0;
+    result &= !minmax_heap__is_copy_enabled(h);
+    result &= minmax_heap__empty_copy_disabled(NULL) == NULL;
+    result &= minmax_heap__empty_copy_enabled(operator_compare, NULL, operator_delete) == NULL;
+    result &= minmax_heap__pop_min(h, &elem) == -1 && minmax_heap__pop_max(h, &elem) == -1;
+    result &= minmax_heap__peek_min(h, &elem) == -1 && minmax_heap__peek_max(h, &elem) == -1;
+    result &= minmax_heap__is_empty(NULL) == -1 && minmax_heap__length(NULL) == SIZE_MAX;
+    result &= minmax_heap__push(NULL, NULL) == -1 && minmax_heap__from_array(h, NULL, 0, 0) == -1;
+
+    minmax_heap__free(h);
+    minmax_heap__free(NULL);
+    return result;
+}
+
+static bool test_minmax_heap__push_pop(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 1000;
+    u32 *values = malloc(sizeof(u32) * N);
+    u32 *sorted = malloc(sizeof(u32) * N);
+    u32 lo = 0, hi = N;
+    elem_t elem;
+    MinMaxHeap h = minmax_heap__empty_copy_disabled(operator_compare);
+
+    srand(3);
+    for (u32 i = 0; i < N; i++) {
+        values[i] = (u32)rand() % 500;
+        sorted[i] = values[i];
+        result &= !minmax_heap__push(h, values + i);
+    }
+    qsort(sorted, N, sizeof(u32), compare_values);
+    result &= minmax_heap__length(h) == N;
+
+    while (lo < hi) {
+        if (rand() % 2) {
+            result &= !minmax_heap__peek_min(h, &elem) && *(u32 *)elem == sorted[lo];
+            result &= !minmax_heap__pop_min(h, &elem) && *(u32 *)elem == sorted[lo++];
+        } else {
+            result &= !minmax_heap__peek_max(h, &elem) && *(u32 *)elem == sorted[hi - 1];
+            result &= !minmax_heap__pop_max(h, &elem) && *(u32 *)elem == sorted[--hi];
+        }
+    }
+    result &= minmax_heap__is_empty(h);
+
+    free(values);
+    free(sorted);
+    minmax_heap__free(h);
+    return result;
+}
+
+static bool test_minmax_heap__from_array(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 500;
+    u32 values[500];
+    u32 extra[3] = {7, 1000, 0};
+    u32 previous = 0;
+    elem_t elem;
+    MinMaxHeap h = minmax_heap__empty_copy_disabled(operator_compare);
+
+    srand(5);
+    for (u32 i = 0; i < N; i++) {
+        values[i] = (u32)rand() % 999 + 1;
+    }
+
+    result &= !minmax_heap__push(h, extra);
+    result &= !minmax_heap__from_array(h, values, N, sizeof(u32));
+    result &= !minmax_heap__from_array(h, extra + 1, 2, sizeof(u32));
+    result &= minmax_heap__length(h) == N + 3;
+
+    result &= !minmax_heap__pop_max(h, &elem) && *(u32 *)elem == 1000;
+    while (!minmax_heap__pop_min(h, &elem)) {
+        result &= *(u32 *)elem >= previous;
+        previous = *(u32 *)elem;
+    }
+
+    minmax_heap__free(h);
+    return result;
+}
+
+static bool test_minmax_heap__copy_enabled(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 values[6] = {4, 8, 1, 9, 4, 2};
+    elem_t elem;
+    MinMaxHeap h = minmax_heap__empty_copy_enabled(operator_compare, operator_copy, operator_delete);
+
+    for (u32 i = 0; i < 6; i++) {
+        minmax_heap__push(h, values + i);
+    }
+    values[3] = 0;
+    result &= minmax_heap__is_copy_enabled(h);
+
+    result &= !minmax_heap__peek_max(h, &elem) && *(u32 *)elem == 9 && elem != values + 3;
+    free(elem);
+    result &= !minmax_heap__pop_min(h, &elem) && *(u32 *)elem == 1;
+    free(elem);
+    result &= !minmax_heap__pop_max(h, NULL) && !minmax_heap__pop_max(h, NULL);
+    result &= !minmax_heap__peek_max(h, &elem) && *(u32 *)elem == 4;
+    free(elem);
+    result &= minmax_heap__length(h) == 3;
+
+    minmax_heap__free(h);
+    return result;
+}
+
+static bool test_minmax_heap__bounded_top(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 2000;
+    const u32 TOP = 10;
+    u32 *values = malloc(sizeof(u32) * N);
+    u32 *sorted = malloc(sizeof(u32) * N);
+    elem_t elem;
+    MinMaxHeap h = minmax_heap__empty_copy_disabled(operator_compare);
+
+    srand(9);
+    for (u32 i = 0; i < N; i++) {
+        values[i] = (u32)rand();
+        sorted[i] = values[i];
+        minmax_heap__push(h, values + i);
+        if (minmax_heap__length(h) > TOP) minmax_heap__pop_min(h, NULL);
+    }
+    qsort(sorted, N, sizeof(u32), compare_values);
+
+    for (u32 i = 0; i < TOP; i++) {
+        result &= !minmax_heap__pop_max(h, &elem) && *(u32 *)elem == sorted[N - 1 - i];
+    }
+
+    free(values);
+    free(sorted);
+    minmax_heap__free(h);
+    return result;
+}
+
+static bool test_minmax_heap__clear(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 values[3] = {3, 1, 2};
+    elem_t elem;
+    MinMaxHeap h = minmax_heap__empty_copy_enabled(operator_compare, operator_copy, operator_delete);
+
+    result &= !minmax_heap__from_array(h, values, 3, sizeof(u32));
+    minmax_heap__clear(h);
+    result &= minmax_heap__is_empty(h) && minmax_heap__pop_max(h, &elem) == -1;
+
+    result &= !minmax_heap__push(h, values + 2);
+    result &= !minmax_heap__peek_min(h, &elem) && *(u32 *)elem == 2;
+    free(elem);
+
+    minmax_heap__free(h);
+    return result;
+}
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST MINMAX HEAP -----------\n");
+
+    print_test_result(test_minmax_heap__empty(), &nb_success, &nb_tests);
+    print_test_result(test_minmax_heap__push_pop(), &nb_success, &nb_tests);
+    print_test_result(test_minmax_heap__from_array(), &nb_success, &nb_tests);
+    print_test_result(test_minmax_heap__copy_enabled(), &nb_success, &nb_tests);
+    print_test_result(test_minmax_heap__bounded_top(), &nb_success, &nb_tests);
+    print_test_result(test_minmax_heap__clear(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
@@ -1,5 +1,6 @@
 #include "common_tests_utils.h"
 #include "../queue/queue.h"
+#include "../common/reclaimer.h"
 #include "../common/defs.h"
 
 #define QUEUE_CREATE(A, B) \
@@ -540,6 +541,430 @@ TEST_ON_NON_EMPTY_QUEUE (
     result &= IS_SORTED(queue__peek_nth, queue__length(w), w, false);
 )
 
+static bool test_queue__sort_on_large_queue(char debug)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 1000;
+    u32 *elems = malloc(sizeof(u32) * N);
+    QUEUE_CREATE(q, w);
+
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = N - i;
+        queue__enqueue(q, elems + i);
+    }
+    queue__sort(q, operator_compare);
+    result &= IS_SORTED(queue__peek_nth, N, q, true);
+    queue__sort(q, operator_compare);
+    result &= IS_SORTED(queue__peek_nth, N, q, true);
+
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = (u32)rand() % 50;
+        queue__enqueue(w, elems + i);
+    }
+    queue__sort(w, operator_compare);
+    result &= IS_SORTED(queue__peek_nth, N, w, false);
+
+    free(elems);
+    QUEUE_FREE(q, w, NULL, NULL);
+    return result;
+}
+
+/* SORT_BY_KEY */
+TEST_ON_NON_EMPTY_QUEUE (
+    test_queue__sort_by_key_on_non_empty_queue, true,
+    result &= !queue__sort_by_key(q, operator_key) && !queue__sort_by_key(w, operator_key);
+    result &= queue__sort_by_key(NULL, operator_key) == -1 && queue__sort_by_key(q, NULL) == -1;
+
+    result &= IS_SORTED(queue__peek_nth, queue__length(q), q, true);
+    result &= IS_SORTED(queue__peek_nth, queue__length(w), w, false);
+
+    elem_t prev;
+    elem_t next;
+    for (u32 i = 0; i + 1 < N; i++) {
+        queue__peek_nth(w, i, &prev);
+        queue__peek_nth(w, i + 1, &next);
+        result &= *(u32 *)prev < *(u32 *)next || (u32 *)prev < (u32 *)next;
+    }
+)
+
+/* SORT_BY_CACHED_KEY */
+TEST_ON_NON_EMPTY_QUEUE (
+    test_queue__sort_by_cached_key_on_non_empty_queue, true,
+    result &= !queue__sort_by_cached_key(q, sizeof(u32), operator_extract_key, operator_key_compare);
+    result &= !queue__sort_by_cached_key(w, sizeof(u32), operator_extract_key, operator_key_compare);
+    result &= queue__sort_by_cached_key(q, 0, operator_extract_key, operator_key_compare) == -1;
+
+    result &= IS_SORTED(queue__peek_nth, queue__length(q), q, true);
+    result &= IS_SORTED(queue__peek_nth, queue__length(w), w, false);
+)
+
+
+/* CLEAR_DEFERRED */
+TEST_ON_NON_EMPTY_QUEUE (
+    test_queue__clear_deferred_on_non_empty_queue, true,
+    queue__clear_deferred(q);
+    queue__clear_deferred(w);
+    reclaimer__flush();
+
+    result = (queue__is_empty(q) && queue__is_empty(w)
+           && !queue__enqueue(q, elems) && !queue__enqueue(w, elems)
+           && queue__length(q) == 1 && queue__length(w) == 1) ? TEST_SUCCESS : TEST_FAILURE;
+)
+
+/* FREE_DEFERRED */
+static bool test_queue__free_deferred(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 elems[4] = {1, 2, 3, 4};
+    Queue q = queue__empty_copy_enabled(operator_copy, operator_delete_counted);
+    Queue w = queue__empty_copy_disabled();
+
+    for (u32 i = 0; i < 4; i++) {
+        delete_counts[elems[i]] = 0;
+        queue__enqueue(q, elems + i);
+    }
+    queue__clear_deferred(q);
+    reclaimer__flush();
+    for (u32 i = 0; i < 4; i++) {
+        result &= delete_counts[elems[i]] == 1;
+    }
+
+    for (u32 i = 0; i < 4; i++) {
+        queue__enqueue(q, elems + i);
+        queue__enqueue(w, elems + i);
+    }
+    queue__free_deferred(q);
+    queue__free_deferred(w);
+    queue__free_deferred(NULL);
+    reclaimer__flush();
+    for (u32 i = 0; i < 4; i++) {
+        result &= delete_counts[elems[i]] == 2;
+    }
+
+    return result;
+}
+
+
+/* INCREMENTAL RESIZE */
+static bool test_queue__incremental_resize(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 1000;
+    u32 *elems = malloc(sizeof(u32) * N);
+    elem_t elem;
+    QUEUE_CREATE(q, w);
+
+    result &= !queue__set_incremental_resize(q, true) && queue__set_incremental_resize(NULL, true) == -1;
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = i;
+        result &= !queue__enqueue(q, elems + i);
+        result &= !queue__peek_back(q, &elem) && *(u32 *)elem == i;
+        free(elem);
+    }
+    result &= COMPARE3(queue__peek_nth, N, q, 0, true);
+
+    for (u32 i = 0; i < N - 10; i++) {
+        result &= !queue__dequeue(q, &elem) && *(u32 *)elem == i;
+        free(elem);
+    }
+    for (u32 i = 0; i < N - 10; i++) {
+        result &= !queue__enqueue(q, elems + i);
+    }
+    for (u32 i = 0; i < N; i++) {
+        result &= !queue__dequeue(q, &elem) && *(u32 *)elem == (i < 10 ? N - 10 + i : i - 10);
+        free(elem);
+    }
+
+    result &= !queue__enqueue(q, elems + 3) && !queue__set_incremental_resize(q, false);
+    result &= queue__search(q, elems + 3, operator_match) != SIZE_MAX;
+
+    Queue e = queue__empty_copy_disabled();
+    queue__set_incremental_resize(e, true);
+    Queue c = queue__copy(e);
+    Queue r = queue__copy(e);
+    Queue a = queue__from_array(NULL, elems, 0, sizeof(u32));
+    queue__set_incremental_resize(a, true);
+    queue__reverse(r);
+    for (u32 i = 0; i < 5; i++) {
+        result &= !queue__enqueue(c, elems + i) && !queue__enqueue(r, elems + i) && !queue__enqueue(a, elems + i);
+    }
+    result &= !queue__peek_front(c, &elem) && *(u32 *)elem == 0 && !queue__peek_back(c, &elem) && *(u32 *)elem == 4;
+    result &= !queue__peek_front(r, &elem) && *(u32 *)elem == 0 && !queue__peek_back(r, &elem) && *(u32 *)elem == 4;
+    result &= !queue__peek_front(a, &elem) && *(u32 *)elem == 0 && queue__length(a) == 5;
+
+    free(elems);
+    queue__free(e);
+    queue__free(c);
+    queue__free(r);
+    queue__free(a);
+    QUEUE_FREE(q, w, NULL, NULL);
+    return result;
+}
+
+/**
+ * Same as 'operator_match', but not the match function of any index so that searches scan the queue
+ */
+static int operator_match_scan(const void *v1, const void *v2) {
+    return operator_match(v1, v2);
+}
+
+static bool test_queue__index(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 1000;
+    u32 *elems = malloc(sizeof(u32) * N);
+    u32 missing = N;
+    elem_t elem;
+    QUEUE_CREATE(q, w);
+
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = i % 100;
+        queue__enqueue(q, elems + i);
+    }
+    result &= queue__set_index(NULL, operator_key, operator_match) == -1 && queue__set_index(q, operator_key, NULL) == -1;
+    result &= !queue__set_index(q, operator_key, operator_match);
+    result &= queue__search(q, elems + 42, operator_match) == 42 && !queue__contains(q, &missing, operator_match);
+
+    for (u32 i = 0; i < 150; i++) {
+        result &= !queue__dequeue(q, &elem);
+        free(elem);
+    }
+    result &= queue__search(q, elems + 42, operator_match) == 242 && queue__contains(q, elems + 42, operator_match);
+
+    result &= !queue__swap(q, 242, 999);
+    result &= queue__search(q, elems + 42, operator_match) == 342 && queue__search(q, elems + 99, operator_match) == 199;
+
+    queue__sort(q, operator_compare);
+    result &= queue__search(q, elems + 0, operator_match) == 150 && queue__search(q, elems + 50, operator_match) == 550;
+
+    queue__clear(q);
+    result &= !queue__contains(q, elems + 42, operator_match) && !queue__enqueue(q, elems + 42);
+    result &= queue__search(q, elems + 42, operator_match) == 0;
+
+    result &= !queue__set_index(q, NULL, NULL) && queue__search(q, elems + 42, operator_match) == 0;
+
+    /* duplicate heavy queue, matching elements share one entry of the index */
+    const u32 D = 100000;
+    u32 same = N;
+    result &= !queue__set_index(w, operator_key, operator_match);
+    for (u32 i = 0; i < D; i++) {
+        result &= !queue__enqueue(w, i % 1000 ? &same : elems + i / 1000);
+    }
+    result &= queue__search(w, &same, operator_match) == 1 && queue__search(w, elems + 3, operator_match) == 3000;
+    result &= !queue__remove_nth(w, 3000) && !queue__contains(w, elems + 3, operator_match);
+    result &= !queue__swap(w, 1, 1000) && queue__search(w, &same, operator_match) == 2;
+    result &= queue__search(w, elems + 1, operator_match) == 1;
+    for (u32 i = 0; i < D - 1; i++) {
+        result &= !queue__dequeue(w, NULL);
+        result &= queue__search(w, &same, operator_match) == queue__search(w, &same, operator_match_scan);
+    }
+    result &= queue__length(w) == 1 && !queue__contains(w, elems + 99, operator_match);
+
+    free(elems);
+    QUEUE_FREE(q, w, NULL, NULL);
+    return result;
+}
+
+static bool test_queue__lazy_reverse(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 elems[5] = {0, 1, 2, 3, 4};
+    elem_t elem;
+    QUEUE_CREATE(q, w);
+
+    for (u32 i = 0; i < 5; i++) {
+        queue__enqueue(q, elems + i);
+    }
+    queue__dequeue(q, &elem);
+    free(elem);
+    queue__reverse(q);
+
+    result &= !queue__peek_front(q, &elem) && *(u32 *)elem == 4;
+    free(elem);
+    result &= !queue__peek_back(q, &elem) && *(u32 *)elem == 1;
+    free(elem);
+    result &= !queue__peek_nth(q, 2, &elem) && *(u32 *)elem == 3;
+    free(elem);
+
+    result &= !queue__enqueue(q, elems) && queue__length(q) == 5;
+    result &= !queue__peek_back(q, &elem) && *(u32 *)elem == 0;
+    free(elem);
+    result &= !queue__dequeue(q, &elem) && *(u32 *)elem == 4;
+    free(elem);
+
+    result &= queue__search(q, elems + 1, operator_match) == 2;
+    result &= !queue__enqueue(q, elems + 4) && !queue__peek_back(q, &elem) && *(u32 *)elem == 4;
+    free(elem);
+    result &= !queue__peek_nth(q, queue__search(q, elems + 4, operator_match), &elem) && *(u32 *)elem == 4;
+    free(elem);
+
+    /* alternating enqueue and reverse, checked against a physically reversed model */
+    u32 values[40];
+    u32 model[40];
+    u32 tmp;
+    for (u32 i = 0; i < 40; i++) {
+        values[i] = i;
+        model[i] = i;
+        result &= !queue__enqueue(w, values + i);
+        queue__reverse(w);
+        for (u32 a = 0, b = i; a < b; a++, b--) {
+            tmp = model[a];
+            model[a] = model[b];
+            model[b] = tmp;
+        }
+    }
+    result &= queue__length(w) == 40 && queue__search(w, values + 39, operator_match) != SIZE_MAX;
+    for (u32 i = 0; i < 40; i++) {
+        result &= !queue__dequeue(w, &elem) && *(u32 *)elem == model[i];
+    }
+
+    QUEUE_FREE(q, w, NULL, NULL);
+    return result;
+}
+
+static bool test_queue__sortedness(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 100;
+    u32 elems[100];
+    u32 missing = N;
+    elem_t elem;
+    QUEUE_CREATE(q, w);
+
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = (i * 37) % N;
+        queue__enqueue(q, elems + i);
+    }
+    result &= !queue__is_sorted(q, operator_compare) && queue__is_sorted(NULL, operator_compare) == -1;
+    result &= queue__sorted_search(q, elems + 1, operator_compare) == 1;
+
+    queue__sort(q, operator_compare);
+    result &= queue__is_sorted(q, operator_compare) && COMPARE3(queue__peek_nth, N, q, 0, true);
+    result &= queue__sorted_search(q, elems + 1, operator_compare) == 37;
+    result &= queue__sorted_search(q, &missing, operator_compare) == SIZE_MAX;
+
+    result &= !queue__dequeue(q, &elem) && *(u32 *)elem == 0;
+    free(elem);
+    result &= !queue__enqueue(q, &missing) && queue__is_sorted(q, operator_compare);
+    result &= !queue__enqueue(q, elems) && !queue__is_sorted(q, operator_compare);
+
+    queue__reverse(q);
+    result &= queue__sorted_search(q, elems + 1, operator_compare) == 65;
+
+    QUEUE_FREE(q, w, NULL, NULL);
+    return result;
+}
+
+static bool test_queue__sample(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 100;
+    u32 elems[100];
+    u32 seen[100] = {0};
+    elem_t *sample;
+    QUEUE_CREATE(q, w);
+
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = i;
+        queue__enqueue(q, elems + i);
+        queue__enqueue(w, elems + i);
+    }
+    const u32 FIRST = 30;
+    for (u32 i = 0; i < FIRST; i++) {
+        queue__dequeue(q, NULL);
+        queue__dequeue(w, NULL);
+    }
+
+    sample = queue__sample(q, 10, 1);
+    for (u32 i = 0; i < 10; i++) {
+        result &= sample && *(u32 *)sample[i] >= FIRST && !seen[*(u32 *)sample[i]] && sample[i] != elems + *(u32 *)sample[i];
+        seen[*(u32 *)sample[i]] = 1;
+        free(sample[i]);
+    }
+    free(sample);
+
+    sample = queue__sample(w, N - FIRST, 2);
+    for (u32 i = 0; i < N - FIRST; i++) {
+        result &= sample && *(u32 *)sample[i] >= FIRST && seen[*(u32 *)sample[i]] != 2;
+        seen[*(u32 *)sample[i]] = 2;
+    }
+    free(sample);
+
+    result &= queue__sample(w, N - FIRST + 1, 3) == NULL && queue__sample(w, 0, 3) == NULL;
+    result &= queue__length(q) == N - FIRST && queue__sample(NULL, 1, 3) == NULL;
+
+    QUEUE_FREE(q, w, NULL, NULL);
+    return result;
+}
+
+/* IMMEDIATE VALUES */
+static bool test_queue__u64(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 16;
+    uint64_t value = 0;
+    QUEUE_CREATE(q, w);
+
+    for (u32 i = 0; i < N; i++) {
+        result &= queue__enqueue_u64(q, i) == -1;
+        result &= !queue__enqueue_u64(w, ((uint64_t)1 << 40) + N - i - 1);
+    }
+
+    result &= queue__search_u64(w, ((uint64_t)1 << 40) + 3) == N - 4;
+    result &= queue__search_u64(w, 3) == SIZE_MAX;
+    queue__sort_u64(w);
+    for (u32 i = 0; i < N; i++) {
+        result &= !queue__peek_nth_u64(w, queue__search_u64(w, ((uint64_t)1 << 40) + i), &value) && value == ((uint64_t)1 << 40) + i;
+    }
+    for (u32 i = 0; i < N; i++) {
+        result &= !queue__dequeue_u64(w, &value) && value == ((uint64_t)1 << 40) + i;
+    }
+    result &= queue__dequeue_u64(w, &value) == -1 && queue__dequeue_u64(q, &value) == -1;
+
+    /* zeros are not taken for removed elements */
+    uint64_t values[4] = {0, 7, 0, 9};
+    for (u32 i = 0; i < 4; i++) {
+        result &= !queue__enqueue_u64(w, values[i]);
+    }
+    result &= queue__enqueue_u64(w, UINT64_MAX) == -1;
+    result &= !queue__remove_nth(w, queue__search_u64(w, 7));
+    queue__clean_NULL(w);
+    result &= queue__length(w) == 3 && !queue__dequeue_u64(w, &value) && value == 0;
+    result &= !queue__dequeue_u64(w, &value) && value == 0 && !queue__dequeue_u64(w, &value) && value == 9;
+
+    QUEUE_FREE(q, w, NULL, NULL);
+    return result;
+}
+
+
+/* COMPACT_ELEMENTS */
+TEST_ON_NON_EMPTY_QUEUE (
+    test_queue__compact_elements_on_non_empty_queue, false,
+    queue__remove_nth(q, 3);
+    result &= !queue__compact_elements(q) && queue__compact_elements(w) == -1;
+    result &= queue__length(q) == N && queue__search(q, NULL, operator_match) == 3;
+    queue__clean_NULL(q);
+    result &= !queue__compact_elements(q);
+    result &= queue__search(q, elems + 4, operator_match) == 3;
+    result &= queue__search(q, elems + N - 1, operator_match) == N - 2;
+)
+
 
 int main(void)
 {
@@ -596,8 +1021,21 @@ int main(void)
     print_test_result(test_queue__shuffle_on_non_empty_queue(false), &nb_success, &nb_tests);
     print_test_result(test_queue__sort_on_empty_queue(false), &nb_success, &nb_tests);
     print_test_result(test_queue__sort_on_non_empty_queue(false), &nb_success, &nb_tests);
+    print_test_result(test_queue__sort_on_large_queue(false), &nb_success, &nb_tests);
+    print_test_result(test_queue__sort_by_key_on_non_empty_queue(false), &nb_success, &nb_tests);
+    print_test_result(test_queue__sort_by_cached_key_on_non_empty_queue(false), &nb_success, &nb_tests);
+    print_test_result(test_queue__clear_deferred_on_non_empty_queue(false), &nb_success, &nb_tests);
+    print_test_result(test_queue__free_deferred(), &nb_success, &nb_tests);
+    print_test_result(test_queue__incremental_resize(), &nb_success, &nb_tests);
+    print_test_result(test_queue__index(), &nb_success, &nb_tests);
+    print_test_result(test_queue__lazy_reverse(), &nb_success, &nb_tests);
+    print_test_result(test_queue__sortedness(), &nb_success, &nb_tests);
+    print_test_result(test_queue__sample(), &nb_success, &nb_tests);
+    print_test_result(test_queue__u64(), &nb_success, &nb_tests);
+    print_test_result(test_queue__compact_elements_on_non_empty_queue(false), &nb_success, &nb_tests);
 
     print_test_summary(nb_success, nb_tests);
+    reclaimer__shutdown();
 
     return TEST_SUCCESS;
 }
@@ -0,0 +1,166 @@
+#include "common_tests_utils.h"
+#include "../reservoir/reservoir.h"
+#include "../common/defs.h"
+
+#define TO_ELEM(__value) ((elem_t)(uintptr_t)(__value))
+#define TO_VALUE(__elem) ((uintptr_t)(__elem))
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_reservoir__empty(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    Reservoir r = reservoir__empty(4, 1, NULL);
+    Reservoir w = reservoir__empty_weighted(4, 1, NULL);
+
+    result &= r && reservoir__length(r) == 0 && reservoir__seen(r) == 0;
+    result &= reservoir__empty(0, 1, NULL) == NULL && reservoir__dump(r) == NULL;
+    result &= reservoir__push(w, NULL) == -1 && reservoir__push_weighted(r, NULL, 1) == -1;
+    result &= reservoir__push_weighted(w, NULL, 0) == -1 && reservoir__push_weighted(w, NULL, -1) == -1;
+    result &= reservoir__to_skip(w) == SIZE_MAX && reservoir__skip(r, 1) == -1;
+    result &= reservoir__length(NULL) == SIZE_MAX && reservoir__push(NULL, NULL) == -1;
+
+    reservoir__free(r);
+    reservoir__free(w);
+    reservoir__free(NULL);
+    return result;
+}
+
+static bool test_reservoir__short_stream(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    elem_t *sample;
+    Reservoir r = reservoir__empty(8, 2, NULL);
+
+    for (u32 i = 0; i < 5; i++) {
+        result &= !reservoir__push(r, TO_ELEM(i));
+    }
+    result &= reservoir__length(r) == 5 && reservoir__to_skip(r) == 0;
+
+    sample = reservoir__dump(r);
+    for (u32 i = 0; i < 5; i++) {
+        result &= sample && TO_VALUE(sample[i]) == i;
+    }
+    result &= reservoir__length(r) == 0 && reservoir__seen(r) == 0;
+
+    free(sample);
+    reservoir__free(r);
+    return result;
+}
+
+static bool test_reservoir__uniform(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 20;
+    const u32 K = 5;
+    const u32 TRIALS = 20000;
+    u32 counts[20] = {0};
+    elem_t *sample;
+    Reservoir r = reservoir__empty(K, 3, NULL);
+
+    for (u32 t = 0; t < TRIALS; t++) {
+        for (u32 i = 0; i < N; i++) {
+            reservoir__push(r, TO_ELEM(i));
+        }
+        result &= reservoir__seen(r) == N;
+        sample = reservoir__dump(r);
+        for (u32 i = 0; i < K; i++) {
+            counts[TO_VALUE(sample[i])]++;
+        }
+        free(sample);
+    }
+
+    /* every element is expected TRIALS*K/N = 5000 times */
+    for (u32 i = 0; i < N; i++) {
+        result &= counts[i] > 4600 && counts[i] < 5400;
+    }
+
+    reservoir__free(r);
+    return result;
+}
+
+static bool test_reservoir__skip(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 100000;
+    u32 pushed = 0;
+    size_t n;
+    Reservoir r = reservoir__empty(10, 4, operator_delete);
+
+    while (reservoir__seen(r) < N) {
+        n = reservoir__to_skip(r);
+        if (n > N - reservoir__seen(r)) n = N - reservoir__seen(r);
+        result &= !reservoir__skip(r, n);
+        if (reservoir__seen(r) < N) {
+            result &= !reservoir__push(r, malloc(sizeof(u32)));
+            pushed++;
+        }
+    }
+
+    result &= reservoir__seen(r) == N && reservoir__length(r) == 10;
+    result &= pushed < 200;
+    result &= reservoir__to_skip(r) > 0 && reservoir__skip(r, reservoir__to_skip(r) + 1) == -1;
+
+    reservoir__free(r);
+    return result;
+}
+
+static bool test_reservoir__weighted(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 TRIALS = 20000;
+    u32 counts[4] = {0};
+    elem_t *sample;
+    Reservoir r = reservoir__empty_weighted(1, 5, operator_delete);
+
+    for (u32 t = 0; t < TRIALS; t++) {
+        for (u32 i = 0; i < 4; i++) {
+            u32 *v = malloc(sizeof(u32));
+            *v = i;
+            result &= !reservoir__push_weighted(r, v, (double)(i + 1));
+        }
+        result &= reservoir__length(r) == 1;
+        sample = reservoir__dump(r);
+        counts[*(u32 *)sample[0]]++;
+        free(sample[0]);
+        free(sample);
+    }
+
+    /* the element of weight i+1 is expected TRIALS*(i+1)/10 times */
+    for (u32 i = 0; i < 4; i++) {
+        result &= counts[i] > (i + 1) * 1840 && counts[i] < (i + 1) * 2160;
+    }
+
+    reservoir__free(r);
+    return result;
+}
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST RESERVOIR -----------\n");
+
+    print_test_result(test_reservoir__empty(), &nb_success, &nb_tests);
+    print_test_result(test_reservoir__short_stream(), &nb_success, &nb_tests);
+    print_test_result(test_reservoir__uniform(), &nb_success, &nb_tests);
+    print_test_result(test_reservoir__skip(), &nb_success, &nb_tests);
+    print_test_result(test_reservoir__weighted(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
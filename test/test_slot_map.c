@@ -0,0 +1,173 @@
+#include "common_tests_utils.h"
+#include "../slot_map/slot_map.h"
+#include "../common/defs.h"
+
+////////////////////////////////////////////////////////////////////
+///     TEST OPERATORS
+////////////////////////////////////////////////////////////////////
+
+static void sum_values(const void *v, void *user_data) {
+    *(u32 *)user_data += *(const u32 *)v;
+}
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_slot_map__empty(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    elem_t elem;
+    slot_handle_t handle;
+    SlotMap m = slot_map__empty_copy_disabled();
+
+    result &= m && slot_map__is_empty(m) && slot_map__length(m) == 0;
+    result &= slot_map__empty_copy_enabled(NULL, operator_delete) == NULL;
+    result &= !slot_map__contains(m, 0) && slot_map__get(m, 0, &elem) == -1 && slot_map__remove(m, 0, NULL) == -1;
+    result &= slot_map__insert(m, NULL, NULL) == -1 && slot_map__insert(NULL, NULL, &handle) == -1;
+    result &= slot_map__is_empty(NULL) == -1 && slot_map__length(NULL) == SIZE_MAX && slot_map__contains(NULL, 0) == -1;
+
+    slot_map__free(m);
+    slot_map__free(NULL);
+    return result;
+}
+
+static bool test_slot_map__insert_get(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 100;
+    u32 elems[100];
+    slot_handle_t handles[100];
+    elem_t elem;
+    SlotMap m = slot_map__empty_copy_enabled(operator_copy, operator_delete);
+
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = i * 3;
+        result &= !slot_map__insert(m, elems + i, handles + i) && handles[i];
+    }
+    result &= slot_map__length(m) == N;
+
+    for (u32 i = 0; i < N; i++) {
+        result &= slot_map__contains(m, handles[i]);
+        result &= !slot_map__get(m, handles[i], &elem) && *(u32 *)elem == i * 3 && elem != elems + i;
+        free(elem);
+    }
+
+    slot_map__free(m);
+    return result;
+}
+
+static bool test_slot_map__stale_handles(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 elems[3] = {1, 2, 3};
+    slot_handle_t a, b, c;
+    elem_t elem;
+    SlotMap m = slot_map__empty_copy_disabled();
+
+    slot_map__insert(m, elems, &a);
+    slot_map__insert(m, elems + 1, &b);
+
+    result &= !slot_map__remove(m, a, &elem) && elem == elems;
+    result &= !slot_map__contains(m, a) && slot_map__remove(m, a, NULL) == -1;
+
+    /* the freed slot is reused with a new generation */
+    result &= !slot_map__insert(m, elems + 2, &c) && c != a && (c & UINT32_MAX) == (a & UINT32_MAX);
+    result &= !slot_map__contains(m, a) && slot_map__get(m, a, &elem) == -1;
+    result &= !slot_map__get(m, c, &elem) && elem == elems + 2;
+    result &= !slot_map__get(m, b, &elem) && elem == elems + 1;
+    result &= !slot_map__contains(m, c + 1) && !slot_map__contains(m, b + ((slot_handle_t)1 << 32));
+
+    slot_map__free(m);
+    return result;
+}
+
+static bool test_slot_map__dense_storage(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 1000;
+    u32 *values = malloc(sizeof(u32) * N);
+    slot_handle_t *handles = malloc(sizeof(slot_handle_t) * N);
+    char *live = calloc(N, sizeof(char));
+    u32 sum = 0, expected = 0;
+    elem_t elem;
+    SlotMap m = slot_map__empty_copy_disabled();
+
+    srand(17);
+    for (u32 i = 0; i < N; i++) {
+        values[i] = (u32)rand() % 1000;
+        slot_map__insert(m, values + i, handles + i);
+        live[i] = true;
+        if (rand() % 2) {
+            u32 j = (u32)rand() % (i + 1);
+            result &= slot_map__remove(m, handles[j], NULL) == (live[j] ? 0 : -1);
+            live[j] = false;
+        }
+    }
+
+    for (u32 i = 0; i < N; i++) {
+        result &= slot_map__contains(m, handles[i]) == live[i];
+        if (live[i]) {
+            expected += values[i];
+            result &= !slot_map__get(m, handles[i], &elem) && elem == values + i;
+        }
+    }
+
+    slot_map__foreach(m, sum_values, &sum);
+    result &= sum == expected;
+
+    free(values);
+    free(handles);
+    free(live);
+    slot_map__free(m);
+    return result;
+}
+
+static bool test_slot_map__clear(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 elems[2] = {5, 6};
+    slot_handle_t a, b, c;
+    elem_t elem;
+    SlotMap m = slot_map__empty_copy_enabled(operator_copy, operator_delete);
+
+    slot_map__insert(m, elems, &a);
+    slot_map__insert(m, elems + 1, &b);
+    slot_map__clear(m);
+
+    result &= slot_map__is_empty(m) && !slot_map__contains(m, a) && !slot_map__contains(m, b);
+    result &= !slot_map__insert(m, elems + 1, &c) && c != a && c != b;
+    result &= !slot_map__get(m, c, &elem) && *(u32 *)elem == 6;
+    free(elem);
+
+    slot_map__free(m);
+    return result;
+}
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST SLOT MAP -----------\n");
+
+    print_test_result(test_slot_map__empty(), &nb_success, &nb_tests);
+    print_test_result(test_slot_map__insert_get(), &nb_success, &nb_tests);
+    print_test_result(test_slot_map__stale_handles(), &nb_success, &nb_tests);
+    print_test_result(test_slot_map__dense_storage(), &nb_success, &nb_tests);
+    print_test_result(test_slot_map__clear(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
@@ -0,0 +1,131 @@
+#include "common_tests_utils.h"
+#include "../sparse_set/sparse_set.h"
+#include "../common/defs.h"
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_sparse_set__empty(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    SparseSet s = sparse_set__empty(16);
+
+    result &= s && sparse_set__is_empty(s) && sparse_set__length(s) == 0 && sparse_set__universe(s) == 16;
+    result &= sparse_set__empty(0) == NULL && sparse_set__ids(s) != NULL;
+    result &= !sparse_set__contains(s, 0) && !sparse_set__contains(s, 16) && sparse_set__remove(s, 0) == -1;
+    result &= sparse_set__insert(s, 16) == -1 && sparse_set__insert(NULL, 0) == -1;
+    result &= sparse_set__is_empty(NULL) == -1 && sparse_set__length(NULL) == SIZE_MAX && sparse_set__contains(NULL, 0) == -1;
+
+    sparse_set__free(s);
+    sparse_set__free(NULL);
+    return result;
+}
+
+static bool test_sparse_set__insert_remove(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    SparseSet s = sparse_set__empty(10);
+
+    result &= !sparse_set__insert(s, 3) && !sparse_set__insert(s, 7) && !sparse_set__insert(s, 0);
+    result &= !sparse_set__insert(s, 7) && sparse_set__length(s) == 3;
+    result &= sparse_set__contains(s, 3) && sparse_set__contains(s, 7) && sparse_set__contains(s, 0);
+    result &= !sparse_set__contains(s, 1) && !sparse_set__contains(s, 9);
+
+    result &= !sparse_set__remove(s, 3) && sparse_set__remove(s, 3) == -1;
+    result &= !sparse_set__contains(s, 3) && sparse_set__length(s) == 2;
+    result &= sparse_set__ids(s)[0] == 0 && sparse_set__ids(s)[1] == 7;
+
+    sparse_set__free(s);
+    return result;
+}
+
+static bool test_sparse_set__clear(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    SparseSet s = sparse_set__empty(100);
+
+    for (size_t i = 0; i < 100; i += 2) {
+        sparse_set__insert(s, i);
+    }
+    sparse_set__clear(s);
+    result &= sparse_set__is_empty(s);
+
+    /* stale sparse entries must not make cleared ids reappear */
+    result &= !sparse_set__insert(s, 50);
+    for (size_t i = 0; i < 100; i++) {
+        result &= sparse_set__contains(s, i) == (i == 50);
+    }
+
+    sparse_set__free(s);
+    return result;
+}
+
+static bool test_sparse_set__random(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const size_t UNIVERSE = 500;
+    char present[500] = {0};
+    size_t length = 0, id;
+    const size_t *ids;
+    SparseSet s = sparse_set__empty(UNIVERSE);
+
+    srand(19);
+    for (u32 i = 0; i < 20000; i++) {
+        id = (size_t)rand() % UNIVERSE;
+        if (rand() % 2) {
+            result &= !sparse_set__insert(s, id);
+            if (!present[id]) length++;
+            present[id] = true;
+        } else {
+            result &= sparse_set__remove(s, id) == (present[id] ? 0 : -1);
+            if (present[id]) length--;
+            present[id] = false;
+        }
+        if (i % 5000 == 4999) {
+            sparse_set__clear(s);
+            length = 0;
+            for (size_t j = 0; j < UNIVERSE; j++) {
+                present[j] = false;
+            }
+        }
+    }
+
+    result &= sparse_set__length(s) == length;
+    ids = sparse_set__ids(s);
+    for (size_t i = 0; i < length; i++) {
+        result &= present[ids[i]] == true;
+        present[ids[i]] = 2;
+    }
+    for (size_t i = 0; i < UNIVERSE; i++) {
+        result &= present[i] != true && sparse_set__contains(s, i) == (present[i] == 2);
+    }
+
+    sparse_set__free(s);
+    return result;
+}
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST SPARSE SET -----------\n");
+
+    print_test_result(test_sparse_set__empty(), &nb_success, &nb_tests);
+    print_test_result(test_sparse_set__insert_remove(), &nb_success, &nb_tests);
+    print_test_result(test_sparse_set__clear(), &nb_success, &nb_tests);
+    print_test_result(test_sparse_set__random(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
@@ -1,5 +1,6 @@
 #include "common_tests_utils.h"
 #include "../stack/stack.h"
+#include "../common/reclaimer.h"
 #include "../common/defs.h"
 
 #define STACK_CREATE(A, B) \
@@ -522,6 +523,417 @@ TEST_ON_NON_EMPTY_STACK (
     result &= IS_SORTED(stack__peek_nth, stack__length(t), t, false);
 )
 
+static bool test_stack__sort_on_large_stack(char debug)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 1000;
+    u32 *elems = malloc(sizeof(u32) * N);
+    STACK_CREATE(s, t);
+
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = N - i;
+        stack__push(s, elems + i);
+    }
+    stack__sort(s, operator_compare);
+    result &= IS_SORTED(stack__peek_nth, N, s, true);
+    stack__sort(s, operator_compare);
+    result &= IS_SORTED(stack__peek_nth, N, s, true);
+
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = (u32)rand() % 50;
+        stack__push(t, elems + i);
+    }
+    stack__sort(t, operator_compare);
+    result &= IS_SORTED(stack__peek_nth, N, t, false);
+
+    free(elems);
+    STACK_FREE(s, t, NULL, NULL);
+    return result;
+}
+
+/* SORT_BY_KEY */
+TEST_ON_NON_EMPTY_STACK (
+    test_stack__sort_by_key_on_non_empty_stack, true,
+    result &= !stack__sort_by_key(s, operator_key) && !stack__sort_by_key(t, operator_key);
+    result &= stack__sort_by_key(NULL, operator_key) == -1 && stack__sort_by_key(s, NULL) == -1;
+
+    result &= IS_SORTED(stack__peek_nth, stack__length(s), s, true);
+    result &= IS_SORTED(stack__peek_nth, stack__length(t), t, false);
+
+    elem_t prev;
+    elem_t next;
+    for (u32 i = 0; i + 1 < N; i++) {
+        stack__peek_nth(t, i, &prev);
+        stack__peek_nth(t, i + 1, &next);
+        result &= *(u32 *)prev < *(u32 *)next || (u32 *)prev < (u32 *)next;
+    }
+)
+
+/* SORT_BY_CACHED_KEY */
+TEST_ON_NON_EMPTY_STACK (
+    test_stack__sort_by_cached_key_on_non_empty_stack, true,
+    result &= !stack__sort_by_cached_key(s, sizeof(u32), operator_extract_key, operator_key_compare);
+    result &= !stack__sort_by_cached_key(t, sizeof(u32), operator_extract_key, operator_key_compare);
+    result &= stack__sort_by_cached_key(s, 0, operator_extract_key, operator_key_compare) == -1;
+
+    result &= IS_SORTED(stack__peek_nth, stack__length(s), s, true);
+    result &= IS_SORTED(stack__peek_nth, stack__length(t), t, false);
+)
+
+
+/* CLEAR_DEFERRED */
+TEST_ON_NON_EMPTY_STACK (
+    test_stack__clear_deferred_on_non_empty_stack, true,
+    stack__clear_deferred(s);
+    stack__clear_deferred(t);
+    reclaimer__flush();
+
+    result = (stack__is_empty(s) && stack__is_empty(t)
+           && !stack__push(s, elems) && !stack__push(t, elems)
+           && stack__length(s) == 1 && stack__length(t) == 1) ? TEST_SUCCESS : TEST_FAILURE;
+)
+
+/* FREE_DEFERRED */
+static bool test_stack__free_deferred(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 elems[4] = {1, 2, 3, 4};
+    Stack s = stack__empty_copy_enabled(operator_copy, operator_delete_counted);
+    Stack t = stack__empty_copy_disabled();
+
+    for (u32 i = 0; i < 4; i++) {
+        delete_counts[elems[i]] = 0;
+        stack__push(s, elems + i);
+    }
+    stack__clear_deferred(s);
+    reclaimer__flush();
+    for (u32 i = 0; i < 4; i++) {
+        result &= delete_counts[elems[i]] == 1;
+    }
+
+    for (u32 i = 0; i < 4; i++) {
+        stack__push(s, elems + i);
+        stack__push(t, elems + i);
+    }
+    stack__free_deferred(s);
+    stack__free_deferred(t);
+    stack__free_deferred(NULL);
+    reclaimer__flush();
+    for (u32 i = 0; i < 4; i++) {
+        result &= delete_counts[elems[i]] == 2;
+    }
+
+    return result;
+}
+
+
+/* INCREMENTAL RESIZE */
+static bool test_stack__incremental_resize(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 1000;
+    u32 *elems = malloc(sizeof(u32) * N);
+    elem_t elem;
+    STACK_CREATE(s, t);
+
+    result &= !stack__set_incremental_resize(s, true) && stack__set_incremental_resize(NULL, true) == -1;
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = i;
+        result &= !stack__push(s, elems + i);
+        result &= !stack__peek_top(s, &elem) && *(u32 *)elem == i;
+        free(elem);
+    }
+    result &= COMPARE3(stack__peek_nth, N, s, 0, true);
+
+    for (u32 i = 0; i < N - 10; i++) {
+        result &= !stack__pop(s, &elem) && *(u32 *)elem == N - i - 1;
+        free(elem);
+    }
+    for (u32 i = 10; i < N; i++) {
+        result &= !stack__push(s, elems + i);
+    }
+    result &= COMPARE3(stack__peek_nth, N, s, 0, true);
+
+    result &= !stack__set_incremental_resize(s, false);
+    result &= stack__search(s, elems + 3, operator_match) == 3;
+
+    u32 step = 32;
+    result &= !stack__set_incremental_resize(t, true);
+    for (u32 i = 0; i < 64; i++) {
+        stack__push(t, elems + i);
+    }
+    stack__filter(t, predicate, &step);
+    result &= stack__length(t) == 2;
+    result &= !stack__pop(t, &elem) && *(u32 *)elem == 32;
+    result &= !stack__push(t, elems + 5) && !stack__push(t, elems + 6);
+    result &= !stack__peek_nth(t, 0, &elem) && *(u32 *)elem == 0;
+    result &= !stack__peek_nth(t, 2, &elem) && *(u32 *)elem == 6 && stack__length(t) == 3;
+
+    Stack e = stack__empty_copy_disabled();
+    stack__set_incremental_resize(e, true);
+    Stack c = stack__copy(e);
+    Stack r = stack__copy(e);
+    Stack a = stack__from_array(NULL, elems, 0, sizeof(u32));
+    stack__set_incremental_resize(a, true);
+    stack__reverse(r);
+    for (u32 i = 0; i < 5; i++) {
+        result &= !stack__push(c, elems + i) && !stack__push(r, elems + i) && !stack__push(a, elems + i);
+    }
+    result &= !stack__peek_top(c, &elem) && *(u32 *)elem == 4 && !stack__peek_nth(c, 0, &elem) && *(u32 *)elem == 0;
+    result &= !stack__peek_top(r, &elem) && *(u32 *)elem == 4 && !stack__peek_nth(r, 0, &elem) && *(u32 *)elem == 0;
+    result &= !stack__peek_top(a, &elem) && *(u32 *)elem == 4 && stack__length(a) == 5;
+
+    free(elems);
+    stack__free(e);
+    stack__free(c);
+    stack__free(r);
+    stack__free(a);
+    STACK_FREE(s, t, NULL, NULL);
+    return result;
+}
+
+static bool test_stack__lazy_reverse(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 elems[5] = {0, 1, 2, 3, 4};
+    elem_t elem;
+    STACK_CREATE(s, t);
+
+    for (u32 i = 0; i < 5; i++) {
+        stack__push(s, elems + i);
+    }
+    stack__reverse(s);
+
+    result &= !stack__peek_top(s, &elem) && *(u32 *)elem == 0;
+    free(elem);
+    result &= !stack__peek_nth(s, 1, &elem) && *(u32 *)elem == 3;
+    free(elem);
+    result &= !stack__swap(s, 0, 4) && !stack__peek_top(s, &elem) && *(u32 *)elem == 4;
+    free(elem);
+
+    result &= !stack__push(s, elems + 2);
+    result &= !stack__pop(s, &elem) && *(u32 *)elem == 2;
+    free(elem);
+    result &= !stack__pop(s, &elem) && *(u32 *)elem == 4;
+    free(elem);
+
+    stack__reverse(s);
+    stack__reverse(s);
+    result &= stack__search(s, elems + 1, operator_match) == 3;
+
+    /* alternating push and reverse, checked against a physically reversed model */
+    u32 values[40];
+    u32 model[40];
+    u32 tmp;
+    size_t mark;
+    for (u32 i = 0; i < 40; i++) {
+        values[i] = i;
+        model[i] = i;
+        result &= !stack__push(t, values + i);
+        stack__reverse(t);
+        for (u32 a = 0, b = i; a < b; a++, b--) {
+            tmp = model[a];
+            model[a] = model[b];
+            model[b] = tmp;
+        }
+    }
+    for (u32 i = 0; i < 40; i++) {
+        result &= !stack__peek_nth(t, i, &elem) && *(u32 *)elem == model[i];
+    }
+    result &= stack__search(t, values + model[7], operator_match) == 7;
+
+    mark = stack__mark(t);
+    result &= !stack__push(t, values) && !stack__push(t, values + 1) && !stack__rollback(t, 30);
+    result &= stack__length(t) == 30 && mark == 40;
+    for (u32 i = 30; i > 0; i--) {
+        result &= !stack__pop(t, &elem) && *(u32 *)elem == model[i - 1];
+    }
+
+    STACK_FREE(s, t, NULL, NULL);
+    return result;
+}
+
+static bool test_stack__sortedness(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 100;
+    u32 elems[100];
+    u32 missing = N;
+    elem_t elem;
+    STACK_CREATE(s, t);
+
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = (i * 37) % N;
+        stack__push(s, elems + i);
+    }
+    result &= !stack__is_sorted(s, operator_compare) && stack__is_sorted(NULL, operator_compare) == -1;
+    result &= stack__sorted_search(s, elems + 1, operator_compare) == 1;
+
+    stack__sort(s, operator_compare);
+    result &= stack__is_sorted(s, operator_compare) && COMPARE3(stack__peek_nth, N, s, 0, true);
+    result &= stack__sorted_search(s, elems + 1, operator_compare) == 37;
+    result &= stack__sorted_search(s, &missing, operator_compare) == SIZE_MAX;
+
+    result &= !stack__pop(s, &elem) && !stack__push(s, elem) && stack__is_sorted(s, operator_compare);
+    free(elem);
+    result &= !stack__push(s, elems) && !stack__is_sorted(s, operator_compare);
+    result &= !stack__pop(s, NULL) && stack__is_sorted(s, operator_compare);
+
+    stack__reverse(s);
+    result &= stack__sorted_search(s, elems + 1, operator_compare) == 62;
+
+    STACK_FREE(s, t, NULL, NULL);
+    return result;
+}
+
+static bool test_stack__sample(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 100;
+    u32 elems[100];
+    u32 seen[100] = {0};
+    elem_t *sample;
+    STACK_CREATE(s, t);
+
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = i;
+        stack__push(s, elems + i);
+        stack__push(t, elems + i);
+    }
+    const u32 FIRST = 0;
+
+    sample = stack__sample(s, 10, 1);
+    for (u32 i = 0; i < 10; i++) {
+        result &= sample && *(u32 *)sample[i] >= FIRST && !seen[*(u32 *)sample[i]] && sample[i] != elems + *(u32 *)sample[i];
+        seen[*(u32 *)sample[i]] = 1;
+        free(sample[i]);
+    }
+    free(sample);
+
+    sample = stack__sample(t, N - FIRST, 2);
+    for (u32 i = 0; i < N - FIRST; i++) {
+        result &= sample && *(u32 *)sample[i] >= FIRST && seen[*(u32 *)sample[i]] != 2;
+        seen[*(u32 *)sample[i]] = 2;
+    }
+    free(sample);
+
+    result &= stack__sample(t, N - FIRST + 1, 3) == NULL && stack__sample(t, 0, 3) == NULL;
+    result &= stack__length(s) == N - FIRST && stack__sample(NULL, 1, 3) == NULL;
+
+    STACK_FREE(s, t, NULL, NULL);
+    return result;
+}
+
+static bool test_stack__mark_rollback(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 100;
+    u32 elems[100];
+    size_t mark_s = 0, mark_t = 0;
+    elem_t elem;
+    STACK_CREATE(s, t);
+
+    stack__set_incremental_resize(t, true);
+    for (u32 i = 0; i < N; i++) {
+        elems[i] = i;
+        if (i == 10) {
+            mark_s = stack__mark(s);
+            mark_t = stack__mark(t);
+        }
+        stack__push(s, elems + i);
+        stack__push(t, elems + i);
+    }
+    result &= mark_s == 10 && mark_t == 10 && stack__mark(NULL) == SIZE_MAX;
+    result &= stack__rollback(s, N + 1) == -1 && stack__rollback(NULL, 0) == -1;
+
+    result &= !stack__rollback(s, mark_s) && !stack__rollback(t, mark_t);
+    result &= stack__length(s) == 10 && stack__length(t) == 10;
+    result &= COMPARE3(stack__peek_nth, 10, s, 0, true) && COMPARE3(stack__peek_nth, 10, t, 0, false);
+    result &= !stack__rollback(s, stack__mark(s)) && stack__length(s) == 10;
+
+    result &= !stack__push(s, elems + 50) && !stack__pop(s, &elem) && *(u32 *)elem == 50;
+    free(elem);
+    for (u32 i = 0; i < 10; i++) {
+        result &= !stack__pop(s, &elem) && *(u32 *)elem == 9 - i;
+        free(elem);
+    }
+
+    stack__reverse(t);
+    result &= !stack__rollback(t, 4) && stack__length(t) == 4;
+    result &= !stack__peek_top(t, &elem) && *(u32 *)elem == 6;
+
+    STACK_FREE(s, t, NULL, NULL);
+    return result;
+}
+
+/* IMMEDIATE VALUES */
+static bool test_stack__u64(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 16;
+    uint64_t value = 0;
+    STACK_CREATE(s, t);
+
+    for (u32 i = 0; i < N; i++) {
+        result &= stack__push_u64(s, i) == -1;
+        result &= !stack__push_u64(t, ((uint64_t)1 << 40) + N - i - 1);
+    }
+
+    result &= stack__search_u64(t, ((uint64_t)1 << 40) + 3) == N - 4;
+    result &= stack__search_u64(t, 3) == SIZE_MAX;
+    stack__sort_u64(t);
+    for (u32 i = 0; i < N; i++) {
+        result &= !stack__peek_nth_u64(t, stack__search_u64(t, ((uint64_t)1 << 40) + i), &value) && value == ((uint64_t)1 << 40) + i;
+    }
+    for (u32 i = 0; i < N; i++) {
+        result &= !stack__pop_u64(t, &value) && value == ((uint64_t)1 << 40) + N-i-1;
+    }
+    result &= stack__pop_u64(t, &value) == -1 && stack__pop_u64(s, &value) == -1;
+
+    /* zeros are not taken for removed elements */
+    uint64_t values[4] = {0, 7, 0, 9};
+    for (u32 i = 0; i < 4; i++) {
+        result &= !stack__push_u64(t, values[i]);
+    }
+    result &= stack__push_u64(t, UINT64_MAX) == -1 && stack__search_u64(t, 0) == 0;
+    result &= !stack__remove_nth(t, 1);
+    stack__clean_NULL(t);
+    result &= stack__length(t) == 3 && !stack__peek_nth_u64(t, 1, &value) && value == 0;
+    result &= !stack__pop_u64(t, &value) && value == 9 && !stack__pop_u64(t, &value) && value == 0;
+
+    STACK_FREE(s, t, NULL, NULL);
+    return result;
+}
+
+
+/* COMPACT_ELEMENTS */
+TEST_ON_NON_EMPTY_STACK (
+    test_stack__compact_elements_on_non_empty_stack, false,
+    stack__remove_nth(s, 3);
+    result &= !stack__compact_elements(s) && stack__compact_elements(t) == -1;
+    result &= stack__length(s) == N && stack__search(s, NULL, operator_match) == 3;
+    stack__clean_NULL(s);
+    result &= !stack__compact_elements(s);
+    result &= stack__search(s, elems + 4, operator_match) == 3;
+    result &= stack__search(s, elems + N - 1, operator_match) == N - 2;
+)
+
 
 int main(void)
 {
@@ -576,8 +988,21 @@ int main(void)
     print_test_result(test_stack__shuffle_on_non_empty_stack(false), &nb_success, &nb_tests);
     print_test_result(test_stack__sort_on_empty_stack(false), &nb_success, &nb_tests);
     print_test_result(test_stack__sort_on_non_empty_stack(false), &nb_success, &nb_tests);
+    print_test_result(test_stack__sort_on_large_stack(false), &nb_success, &nb_tests);
+    print_test_result(test_stack__sort_by_key_on_non_empty_stack(false), &nb_success, &nb_tests);
+    print_test_result(test_stack__sort_by_cached_key_on_non_empty_stack(false), &nb_success, &nb_tests);
+    print_test_result(test_stack__clear_deferred_on_non_empty_stack(false), &nb_success, &nb_tests);
+    print_test_result(test_stack__free_deferred(), &nb_success, &nb_tests);
+    print_test_result(test_stack__incremental_resize(), &nb_success, &nb_tests);
+    print_test_result(test_stack__lazy_reverse(), &nb_success, &nb_tests);
+    print_test_result(test_stack__sortedness(), &nb_success, &nb_tests);
+    print_test_result(test_stack__sample(), &nb_success, &nb_tests);
+    print_test_result(test_stack__mark_rollback(), &nb_success, &nb_tests);
+    print_test_result(test_stack__u64(), &nb_success, &nb_tests);
+    print_test_result(test_stack__compact_elements_on_non_empty_stack(false), &nb_success, &nb_tests);
 
     print_test_summary(nb_success, nb_tests);
+    reclaimer__shutdown();
 
     return TEST_SUCCESS;
 }
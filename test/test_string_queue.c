@@ -0,0 +1,138 @@
+#include <string.h>
+
+#include "common_tests_utils.h"
+#include "../string_queue/string_queue.h"
+#include "../common/defs.h"
+
+#define N_WORDS 12
+
+static const char *words[N_WORDS] = {
+    "tenant", "host", "", "a", "tenant-identifier-0001", "tenant-identifier-0002",
+    "zebra", "tenant", "abcdefgh", "abcdefghi", "abcdefg", "host.example.org"
+};
+
+#define TEST_ON_STRING_QUEUE(__name, __expr) \
+static bool __name(char debug) \
+{ \
+    printf("%s... ", __func__); \
+    bool result = TEST_SUCCESS; \
+    StringQueue q = string_queue__empty(); \
+    for (u32 i = 0; i < N_WORDS; i++) { \
+        result &= !string_queue__enqueue(q, words[i]); \
+    } \
+    if (debug) string_queue__debug(q); \
+    __expr \
+    if (debug) string_queue__debug(q); \
+    string_queue__free(q); \
+    return result; \
+}
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_string_queue__empty(void)
+{
+    printf("%s... ", __func__);
+
+    StringQueue q = string_queue__empty();
+    bool result = (q && string_queue__is_empty(q) == 1 && string_queue__length(q) == 0) ? TEST_SUCCESS : TEST_FAILURE;
+
+    string_queue__free(q);
+    return result;
+}
+
+TEST_ON_STRING_QUEUE (
+    test_string_queue__enqueue_and_peek_nth,
+    const char *str;
+    size_t len;
+    result &= string_queue__length(q) == N_WORDS;
+    for (u32 i = 0; i < N_WORDS; i++) {
+        result &= !string_queue__peek_nth(q, i, &str, &len) && len == strlen(words[i]) && !strcmp(str, words[i]);
+    }
+    result &= string_queue__peek_nth(q, N_WORDS, &str, &len) == -1;
+    result &= !string_queue__enqueue_n(q, "hostname", 4) && !string_queue__peek_nth(q, N_WORDS, &str, NULL) && !strcmp(str, "host");
+)
+
+TEST_ON_STRING_QUEUE (
+    test_string_queue__dequeue_and_pop_back,
+    char *str = NULL;
+    result &= !string_queue__pop_back(q, &str) && !strcmp(str, words[N_WORDS - 1]);
+    free(str);
+    for (u32 i = 0; i + 1 < N_WORDS; i++) {
+        result &= !string_queue__dequeue(q, &str) && !strcmp(str, words[i]);
+        free(str);
+    }
+    result &= string_queue__dequeue(q, NULL) == -1 && string_queue__pop_back(q, NULL) == -1;
+    result &= !string_queue__enqueue(q, "again") && string_queue__length(q) == 1;
+)
+
+TEST_ON_STRING_QUEUE (
+    test_string_queue__search_and_contains,
+    result &= string_queue__search(q, "tenant") == 0;
+    result &= string_queue__search(q, "") == 2;
+    result &= string_queue__search(q, "tenant-identifier-0002") == 5;
+    result &= string_queue__search(q, "abcdefghi") == 9;
+    result &= string_queue__contains(q, "tenant-identifier-0003") == 0;
+    result &= string_queue__contains(q, "abcdefgh") == 1;
+    result &= string_queue__contains(q, NULL) == -1;
+)
+
+TEST_ON_STRING_QUEUE (
+    test_string_queue__sort,
+    const char *a;
+    const char *b;
+    string_queue__sort(q);
+    for (u32 i = 0; i + 1 < N_WORDS; i++) {
+        string_queue__peek_nth(q, i, &a, NULL);
+        string_queue__peek_nth(q, i + 1, &b, NULL);
+        result &= strcmp(a, b) <= 0;
+    }
+)
+
+TEST_ON_STRING_QUEUE (
+    test_string_queue__pool_reuse,
+    const char *str;
+    char buffer[16];
+    for (u32 i = 0; i < 1000; i++) {
+        snprintf(buffer, sizeof(buffer), "token-%u", i);
+        result &= !string_queue__enqueue(q, buffer);
+        result &= !string_queue__dequeue(q, NULL);
+    }
+    result &= string_queue__length(q) == N_WORDS;
+    string_queue__peek_nth(q, 0, &str, NULL);
+    result &= !string_queue__enqueue(q, str);
+    for (u32 i = 0; i < N_WORDS; i++) {
+        snprintf(buffer, sizeof(buffer), "token-%u", 1000 - N_WORDS + i);
+        string_queue__peek_nth(q, i, &str, NULL);
+        result &= !strcmp(str, buffer);
+    }
+    string_queue__peek_nth(q, N_WORDS, &str, NULL);
+    result &= !strcmp(str, "token-988");
+)
+
+TEST_ON_STRING_QUEUE (
+    test_string_queue__clear,
+    string_queue__clear(q);
+    result &= string_queue__is_empty(q) == 1 && !string_queue__enqueue(q, "x") && string_queue__search(q, "x") == 0;
+)
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST STRING QUEUE -----------\n");
+
+    print_test_result(test_string_queue__empty(), &nb_success, &nb_tests);
+    print_test_result(test_string_queue__enqueue_and_peek_nth(false), &nb_success, &nb_tests);
+    print_test_result(test_string_queue__dequeue_and_pop_back(false), &nb_success, &nb_tests);
+    print_test_result(test_string_queue__search_and_contains(false), &nb_success, &nb_tests);
+    print_test_result(test_string_queue__sort(false), &nb_success, &nb_tests);
+    print_test_result(test_string_queue__pool_reuse(false), &nb_success, &nb_tests);
+    print_test_result(test_string_queue__clear(false), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
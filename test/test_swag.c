@@ -0,0 +1,221 @@
+#include "common_tests_utils.h"
+#include "../swag/swag.h"
+#include "../common/defs.h"
+
+////////////////////////////////////////////////////////////////////
+///     TEST OPERATORS
+////////////////////////////////////////////////////////////////////
+
+/**
+ * Decimal number, concatenating numbers is associative but not commutative
+ */
+typedef struct
+{
+    uint64_t value;
+    uint64_t scale;
+} Number;
+
+static const Number EMPTY_NUMBER = {0, 1};
+
+#define TO_ELEM(__value) ((elem_t)(uintptr_t)(__value))
+#define TO_VALUE(__elem) ((uintptr_t)(__elem))
+
+static void *operator_sum(const void *a, const void *b, void *user_data) {
+    (*(u32 *)user_data)++;
+    return TO_ELEM(TO_VALUE(a) + TO_VALUE(b));
+}
+
+static void *operator_min(const void *a, const void *b, void *user_data) {
+    (void)user_data;
+    return TO_VALUE(a) < TO_VALUE(b) ? (elem_t)a : (elem_t)b;
+}
+
+static void *operator_concat(const void *a, const void *b, void *user_data) {
+    (void)user_data;
+    const Number *x = a;
+    const Number *y = b;
+    Number *res = malloc(sizeof(Number));
+    res->value = x->value * y->scale + y->value;
+    res->scale = x->scale * y->scale;
+    return res;
+}
+
+static Number *new_digit(const uint64_t d) {
+    Number *n = malloc(sizeof(Number));
+    n->value = d;
+    n->scale = 10;
+    return n;
+}
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_swag__empty(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 calls = 0;
+    elem_t elem;
+    Swag w = swag__empty(operator_sum, TO_ELEM(0), &calls, NULL);
+
+    result &= w && swag__is_empty(w) && swag__length(w) == 0;
+    result &= swag__empty(NULL, NULL, NULL, NULL) == NULL;
+    result &= !swag__query(w, &elem) && TO_VALUE(elem) == 0;
+    result &= swag__pop(w, &elem) == -1 && swag__query(w, NULL) == -1;
+    result &= swag__is_empty(NULL) == -1 && swag__length(NULL) == SIZE_MAX;
+    result &= swag__push(NULL, NULL) == -1 && swag__pop(NULL, NULL) == -1;
+
+    swag__free(w);
+    swag__free(NULL);
+    return result;
+}
+
+static bool test_swag__rolling_sum(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 1000;
+    const u32 WIDTH = 16;
+    u32 calls = 0;
+    uint64_t sum = 0;
+    elem_t elem;
+    Swag w = swag__empty(operator_sum, TO_ELEM(0), &calls, NULL);
+
+    for (u32 i = 0; i < N; i++) {
+        result &= !swag__push(w, TO_ELEM(i));
+        sum += i;
+        if (swag__length(w) > WIDTH) {
+            result &= !swag__pop(w, &elem) && TO_VALUE(elem) == i - WIDTH;
+            sum -= i - WIDTH;
+        }
+        result &= !swag__query(w, &elem) && TO_VALUE(elem) == sum;
+    }
+
+    result &= swag__length(w) == WIDTH;
+    result &= calls <= 4 * N;
+
+    swag__free(w);
+    return result;
+}
+
+static bool test_swag__non_commutative(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    elem_t elem;
+    Swag w = swag__empty(operator_concat, (elem_t)&EMPTY_NUMBER, NULL, free);
+
+    for (u32 d = 1; d <= 5; d++) {
+        swag__push(w, new_digit(d));
+    }
+    result &= !swag__query(w, &elem) && ((Number *)elem)->value == 12345;
+
+    result &= !swag__pop(w, &elem) && ((Number *)elem)->value == 1;
+    free(elem);
+    result &= !swag__query(w, &elem) && ((Number *)elem)->value == 2345;
+
+    swag__push(w, new_digit(6));
+    swag__push(w, new_digit(7));
+    result &= !swag__query(w, &elem) && ((Number *)elem)->value == 234567;
+
+    for (u32 d = 2; d <= 5; d++) {
+        result &= !swag__pop(w, &elem) && ((Number *)elem)->value == d;
+        free(elem);
+    }
+    result &= !swag__query(w, &elem) && ((Number *)elem)->value == 67 && ((Number *)elem)->scale == 100;
+
+    while (!swag__pop(w, &elem)) {
+        free(elem);
+    }
+    result &= !swag__query(w, &elem) && elem == &EMPTY_NUMBER;
+
+    swag__free(w);
+    return result;
+}
+
+static bool test_swag__interleaved(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 2000;
+    u32 *values = malloc(sizeof(u32) * N);
+    u32 first = 0, last = 0, min;
+    elem_t elem;
+    Swag w = swag__empty(operator_min, TO_ELEM(UINT32_MAX), NULL, NULL);
+
+    srand(11);
+    while (last < N) {
+        if (first == last || rand() % 3) {
+            values[last] = (u32)rand() % 10000;
+            result &= !swag__push(w, TO_ELEM(values[last]));
+            last++;
+        } else {
+            result &= !swag__pop(w, &elem) && TO_VALUE(elem) == values[first];
+            first++;
+        }
+
+        min = UINT32_MAX;
+        for (u32 i = first; i < last; i++) {
+            if (values[i] < min) min = values[i];
+        }
+        result &= !swag__query(w, &elem) && TO_VALUE(elem) == min;
+        result &= swag__length(w) == last - first;
+    }
+
+    free(values);
+    swag__free(w);
+    return result;
+}
+
+static bool test_swag__clear(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    Number *digits[6];
+    elem_t elem;
+    Swag w = swag__empty(operator_concat, (elem_t)&EMPTY_NUMBER, NULL, free);
+
+    for (u32 d = 0; d < 6; d++) {
+        digits[d] = new_digit(d + 1);
+        swag__push(w, digits[d]);
+    }
+    swag__pop(w, &elem);
+    swag__query(w, &elem);
+
+    swag__clear(w);
+    result &= swag__is_empty(w) && !swag__query(w, &elem) && elem == &EMPTY_NUMBER;
+
+    swag__push(w, digits[2]);
+    swag__push(w, digits[1]);
+    result &= !swag__query(w, &elem) && ((Number *)elem)->value == 32;
+
+    swag__free(w);
+    for (u32 d = 0; d < 6; d++) {
+        free(digits[d]);
+    }
+    return result;
+}
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST SWAG -----------\n");
+
+    print_test_result(test_swag__empty(), &nb_success, &nb_tests);
+    print_test_result(test_swag__rolling_sum(), &nb_success, &nb_tests);
+    print_test_result(test_swag__non_commutative(), &nb_success, &nb_tests);
+    print_test_result(test_swag__interleaved(), &nb_success, &nb_tests);
+    print_test_result(test_swag__clear(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
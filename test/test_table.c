@@ -0,0 +1,160 @@
+#include "common_tests_utils.h"
+#include "../table/table.h"
+#include "../common/defs.h"
+
+typedef struct {
+    uint64_t timestamp;
+    u32 value;
+    char tag;
+} Row;
+
+#define TABLE_CREATE(A) \
+    size_t __sizes[3] = {sizeof(uint64_t), sizeof(u32), sizeof(char)}; \
+    Table A = table__empty(3, __sizes)
+
+#define TABLE_PUSH(A, R) \
+({ \
+    const void *__row[3] = {&(R).timestamp, &(R).value, &(R).tag}; \
+    table__push_row(A, __row); \
+})
+
+#define TEST_ON_TABLE(__name, __rand, __expr) \
+static bool __name(void) \
+{ \
+    printf("%s... ", __func__); \
+    bool result = TEST_SUCCESS; \
+    u32 N = 100; \
+    Row *rows = malloc(sizeof(Row) * N); \
+    size_t *res = malloc(sizeof(size_t) * N); \
+    TABLE_CREATE(t); \
+    for (u32 i = 0; i < N; i++) { \
+        rows[i].timestamp = __rand ? (uint64_t)(rand() % 50) : i; \
+        rows[i].value = i * 3; \
+        rows[i].tag = (char)('a' + i % 26); \
+        result &= !TABLE_PUSH(t, rows[i]); \
+    } \
+    __expr \
+    free(res); \
+    free(rows); \
+    table__free(t); \
+    return result; \
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static char is_even_u32(const void *v, void *user_data) {
+    return *(const u32 *)v % 2 == 0;
+}
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_table__empty(void)
+{
+    printf("%s... ", __func__);
+
+    size_t sizes[2] = {4, 0};
+    TABLE_CREATE(t);
+    bool result = (t && table__is_empty(t) == 1 && table__length(t) == 0
+                && !table__empty(0, sizes) && !table__empty(2, sizes)) ? TEST_SUCCESS : TEST_FAILURE;
+
+    table__free(t);
+    return result;
+}
+
+TEST_ON_TABLE (
+    test_table__push_and_get, false,
+    uint64_t timestamp;
+    u32 value;
+    char tag;
+    result &= table__length(t) == N;
+    for (u32 i = 0; i < N; i++) {
+        result &= !table__get(t, i, 0, &timestamp) && timestamp == i;
+        result &= !table__get(t, i, 1, &value) && value == i * 3;
+        result &= !table__get(t, i, 2, &tag) && tag == rows[i].tag;
+    }
+    result &= table__get(t, N, 0, &timestamp) == -1 && table__get(t, 0, 3, &timestamp) == -1;
+    result &= ((const u32 *)table__column(t, 1))[N - 1] == (N - 1) * 3;
+)
+
+TEST_ON_TABLE (
+    test_table__pop_row, false,
+    Row r;
+    void *row[3];
+    row[0] = &r.timestamp;
+    row[1] = &r.value;
+    row[2] = &r.tag;
+    for (u32 i = 0; i < N; i++) {
+        result &= !table__pop_row(t, row) && r.timestamp == N - i - 1 && r.value == (N - i - 1) * 3;
+    }
+    result &= table__pop_row(t, NULL) == -1 && table__is_empty(t) == 1;
+)
+
+TEST_ON_TABLE (
+    test_table__filter_column, false,
+    size_t k = table__filter_column(t, 1, is_even_u32, NULL, res);
+    result &= k == N / 2;
+    for (size_t i = 0; i < k; i++) {
+        result &= res[i] == 2 * i;
+    }
+)
+
+TEST_ON_TABLE (
+    test_table__filter_range_u64, false,
+    size_t k = table__filter_range_u64(t, 0, 10, 19, res);
+    result &= k == 10;
+    for (size_t i = 0; i < k; i++) {
+        result &= res[i] == 10 + i;
+    }
+    result &= table__filter_range_u64(t, 1, 0, 1, res) == SIZE_MAX;
+    result &= table__filter_range_u64(t, 0, 19, 10, res) == 0;
+)
+
+TEST_ON_TABLE (
+    test_table__sort_by_column_and_permute, true,
+    uint64_t a;
+    uint64_t b;
+    u32 va;
+    u32 vb;
+    result &= !table__sort_by_column(t, 0, compare_u64, res);
+    result &= !table__permute(t, res);
+    for (u32 i = 0; i + 1 < N; i++) {
+        table__get(t, i, 0, &a);
+        table__get(t, i + 1, 0, &b);
+        table__get(t, i, 1, &va);
+        table__get(t, i + 1, 1, &vb);
+        result &= a < b || (a == b && va < vb);
+        result &= rows[va / 3].timestamp == a;
+    }
+)
+
+TEST_ON_TABLE (
+    test_table__clear, true,
+    table__clear(t);
+    result &= table__is_empty(t) == 1 && !TABLE_PUSH(t, rows[0]) && table__length(t) == 1;
+)
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST TABLE -----------\n");
+
+    print_test_result(test_table__empty(), &nb_success, &nb_tests);
+    print_test_result(test_table__push_and_get(), &nb_success, &nb_tests);
+    print_test_result(test_table__pop_row(), &nb_success, &nb_tests);
+    print_test_result(test_table__filter_column(), &nb_success, &nb_tests);
+    print_test_result(test_table__filter_range_u64(), &nb_success, &nb_tests);
+    print_test_result(test_table__sort_by_column_and_permute(), &nb_success, &nb_tests);
+    print_test_result(test_table__clear(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
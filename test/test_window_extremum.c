@@ -0,0 +1,168 @@
+#include "common_tests_utils.h"
+#include "../window_extremum/window_extremum.h"
+#include "../common/defs.h"
+
+////////////////////////////////////////////////////////////////////
+///     TEST OPERATORS
+////////////////////////////////////////////////////////////////////
+
+static int operator_reverse_compare(const void *v1, const void *v2) {
+    return operator_compare(v2, v1);
+}
+
+/**
+ * Extremum of the last 'width' values ending at 'end' computed by scanning them
+ */
+static u32 window_scan(const u32 *values, const u32 end, const u32 width, const char max) {
+    u32 res = values[end];
+    for (u32 i = end >= width - 1 ? end - (width - 1) : 0; i < end; i++) {
+        if (max ? values[i] > res : values[i] < res) res = values[i];
+    }
+    return res;
+}
+
+////////////////////////////////////////////////////////////////////
+///     TEST SUITE
+////////////////////////////////////////////////////////////////////
+
+static bool test_window_extremum__empty(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    elem_t elem;
+    uint64_t stamp;
+    WindowExtremum w = window_extremum__empty(4, operator_compare, NULL);
+
+    result &= w && window_extremum__is_empty(w) && window_extremum__length(w) == 0;
+    result &= window_extremum__empty(4, NULL, NULL) == NULL;
+    result &= window_extremum__peek(w, &elem) == -1 && window_extremum__peek_stamp(w, &stamp) == -1;
+    result &= window_extremum__is_empty(NULL) == -1 && window_extremum__length(NULL) == SIZE_MAX;
+    result &= window_extremum__push(NULL, NULL) == -1 && window_extremum__expire(NULL, 0) == -1;
+
+    window_extremum__free(w);
+    window_extremum__free(NULL);
+    return result;
+}
+
+static bool test_window_extremum__sliding_min_max(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 1000;
+    const u32 WIDTH = 16;
+    u32 *values = malloc(sizeof(u32) * N);
+    elem_t min, max;
+    WindowExtremum w_min = window_extremum__empty(WIDTH, operator_compare, NULL);
+    WindowExtremum w_max = window_extremum__empty(WIDTH, operator_reverse_compare, NULL);
+
+    srand(7);
+    for (u32 i = 0; i < N; i++) {
+        values[i] = (u32)rand() % 100;
+        result &= !window_extremum__push(w_min, values + i) && !window_extremum__push(w_max, values + i);
+        result &= !window_extremum__peek(w_min, &min) && *(u32 *)min == window_scan(values, i, WIDTH, false);
+        result &= !window_extremum__peek(w_max, &max) && *(u32 *)max == window_scan(values, i, WIDTH, true);
+        result &= window_extremum__length(w_min) <= WIDTH;
+    }
+
+    free(values);
+    window_extremum__free(w_min);
+    window_extremum__free(w_max);
+    return result;
+}
+
+static bool test_window_extremum__stamps(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    u32 values[5] = {5, 3, 8, 4, 6};
+    elem_t elem;
+    uint64_t stamp;
+    WindowExtremum w = window_extremum__empty(100, operator_compare, NULL);
+
+    result &= !window_extremum__push_at(w, values, 10) && !window_extremum__push_at(w, values + 1, 50);
+    result &= !window_extremum__push_at(w, values + 2, 60) && window_extremum__push_at(w, values + 3, 20) == -1;
+    result &= !window_extremum__peek(w, &elem) && *(u32 *)elem == 3;
+    result &= !window_extremum__peek_stamp(w, &stamp) && stamp == 50;
+
+    result &= !window_extremum__push_at(w, values + 3, 149) && !window_extremum__peek(w, &elem) && *(u32 *)elem == 3;
+    result &= !window_extremum__push_at(w, values + 4, 150) && !window_extremum__peek(w, &elem) && *(u32 *)elem == 4;
+    result &= window_extremum__length(w) == 2;
+
+    result &= !window_extremum__expire(w, 150) && !window_extremum__peek(w, &elem) && *(u32 *)elem == 6;
+    result &= !window_extremum__expire(w, 151) && window_extremum__is_empty(w);
+
+    window_extremum__free(w);
+    return result;
+}
+
+static bool test_window_extremum__unbounded(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    const u32 N = 100;
+    u32 values[100];
+    elem_t elem;
+    WindowExtremum w = window_extremum__empty(0, operator_compare, NULL);
+
+    for (u32 i = 0; i < N; i++) {
+        values[i] = N - i;
+        result &= !window_extremum__push(w, values + i);
+    }
+    result &= window_extremum__length(w) == 1 && !window_extremum__peek(w, &elem) && *(u32 *)elem == 1;
+
+    window_extremum__clear(w);
+    for (u32 i = 0; i < N; i++) {
+        result &= !window_extremum__push(w, values + N - 1 - i);
+    }
+    result &= window_extremum__length(w) == N;
+    result &= !window_extremum__expire(w, 42) && !window_extremum__peek(w, &elem) && *(u32 *)elem == 43;
+
+    window_extremum__free(w);
+    return result;
+}
+
+static bool test_window_extremum__owned_elements(void)
+{
+    printf("%s... ", __func__);
+
+    bool result = TEST_SUCCESS;
+    elem_t elem;
+    WindowExtremum w = window_extremum__empty(8, operator_compare, operator_delete);
+
+    for (u32 i = 0; i < 100; i++) {
+        u32 value = (i * 7) % 13;
+        result &= !window_extremum__push(w, operator_copy(&value));
+    }
+    result &= !window_extremum__peek(w, &elem) && *(u32 *)elem == 1;
+
+    window_extremum__clear(w);
+    result &= window_extremum__is_empty(w);
+    for (u32 i = 0; i < 10; i++) {
+        result &= !window_extremum__push(w, operator_copy(&i));
+    }
+
+    window_extremum__free(w);
+    return result;
+}
+
+
+int main(void)
+{
+    int nb_success = 0;
+    int nb_tests = 0;
+    printf("----------- TEST WINDOW EXTREMUM -----------\n");
+
+    print_test_result(test_window_extremum__empty(), &nb_success, &nb_tests);
+    print_test_result(test_window_extremum__sliding_min_max(), &nb_success, &nb_tests);
+    print_test_result(test_window_extremum__stamps(), &nb_success, &nb_tests);
+    print_test_result(test_window_extremum__unbounded(), &nb_success, &nb_tests);
+    print_test_result(test_window_extremum__owned_elements(), &nb_success, &nb_tests);
+
+    print_test_summary(nb_success, nb_tests);
+
+    return TEST_SUCCESS;
+}
@@ -0,0 +1,199 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "window_extremum.h"
+
+#define DEFAULT_WINDOW_CAPACITY 4
+
+///////////////////////////////////////////////////////////////////////////////
+///     WINDOW EXTREMUM STRUCTURE
+///////////////////////////////////////////////////////////////////////////////
+
+typedef struct
+{
+    elem_t elem;
+    uint64_t stamp;
+} Candidate;
+
+struct WindowExtremumSt
+{
+    Candidate *candidates;
+    size_t front;
+    size_t back;
+    size_t length;
+    size_t capacity;
+    uint64_t width;
+    uint64_t last_stamp;
+    char started;
+    compare_func_t cmp;
+    delete_operator_t operator_delete;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///     WINDOW EXTREMUM MACRO UTILITARIES
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Macro to resize the candidates array
+ */
+#define WINDOW_RESIZE(__ptr, __new_capacity) \
+({ \
+    int __result_res = FAILURE; \
+    Candidate *__realloc_res = realloc((__ptr)->candidates, sizeof(Candidate) * (__new_capacity)); \
+    if (__realloc_res) { \
+        (__ptr)->candidates = __realloc_res; \
+        (__ptr)->capacity = (__new_capacity); \
+        __result_res = SUCCESS; \
+    } \
+    (char)__result_res; \
+})
+
+/**
+ * Macro to shift all candidates to the left of the candidates array
+ */
+#define WINDOW_SHIFT(__ptr) \
+    memmove((__ptr)->candidates, (__ptr)->candidates + (__ptr)->front, sizeof(Candidate) * (__ptr)->length); \
+    (__ptr)->front = 0; \
+    (__ptr)->back = (__ptr)->length
+
+static inline void drop(const WindowExtremum w, const elem_t elem) {
+    if (w->operator_delete) w->operator_delete(elem);
+}
+
+static void expire_before(const WindowExtremum w, const uint64_t stamp) {
+    while (w->length && w->candidates[w->front].stamp < stamp) {
+        drop(w, w->candidates[w->front].elem);
+        w->front++;
+        w->length--;
+    }
+    if (!w->length) {
+        w->front = 0;
+        w->back = 0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///     WINDOW EXTREMUM FUNCTIONS TO EXPORT
+///////////////////////////////////////////////////////////////////////////////
+
+WindowExtremum window_extremum__empty(const uint64_t width, const compare_func_t cmp, const delete_operator_t delete_op) {
+    if (!cmp) return NULL;
+
+    WindowExtremum w = malloc(sizeof(struct WindowExtremumSt));
+    if (!w) return NULL;
+
+    w->candidates = malloc(sizeof(Candidate) * DEFAULT_WINDOW_CAPACITY);
+    if (!w->candidates) {
+        free(w);
+        return NULL;
+    }
+
+    w->front = 0;
+    w->back = 0;
+    w->length = 0;
+    w->capacity = DEFAULT_WINDOW_CAPACITY;
+    w->width = width;
+    w->last_stamp = 0;
+    w->started = false;
+    w->cmp = cmp;
+    w->operator_delete = delete_op;
+
+    return w;
+}
+
+inline char window_extremum__is_empty(const WindowExtremum w) {
+    return !w ? FAILURE : !w->length;
+}
+
+inline size_t window_extremum__length(const WindowExtremum w) {
+    return !w ? SIZE_MAX : w->length;
+}
+
+char window_extremum__push(const WindowExtremum w, const elem_t element) {
+    if (!w) return FAILURE;
+
+    return window_extremum__push_at(w, element, w->started ? w->last_stamp + 1 : 0);
+}
+
+char window_extremum__push_at(const WindowExtremum w, const elem_t element, const uint64_t stamp) {
+    if (!w || (w->started && stamp < w->last_stamp)) return FAILURE;
+
+    if (w->width && stamp >= w->width) {
+        expire_before(w, stamp - w->width + 1);
+    }
+
+    if (w->back == w->capacity) {
+        if (w->front >= w->capacity>>1) {
+            WINDOW_SHIFT(w);
+        } else if (WINDOW_RESIZE(w, w->capacity<<1) < 0) {
+            return FAILURE;
+        }
+    }
+
+    /* candidates not less than the new element can no longer be the extremum */
+    while (w->length && w->cmp(&w->candidates[w->back - 1].elem, &element) >= 0) {
+        w->back--;
+        w->length--;
+        drop(w, w->candidates[w->back].elem);
+    }
+
+    w->candidates[w->back].elem = element;
+    w->candidates[w->back].stamp = stamp;
+    w->back++;
+    w->length++;
+    w->last_stamp = stamp;
+    w->started = true;
+
+    return SUCCESS;
+}
+
+char window_extremum__expire(const WindowExtremum w, const uint64_t stamp) {
+    if (!w) return FAILURE;
+
+    expire_before(w, stamp);
+
+    return SUCCESS;
+}
+
+char window_extremum__peek(const WindowExtremum w, elem_t *extremum) {
+    if (!w || !w->length || !extremum) return FAILURE;
+
+    *extremum = w->candidates[w->front].elem;
+
+    return SUCCESS;
+}
+
+char window_extremum__peek_stamp(const WindowExtremum w, uint64_t *stamp) {
+    if (!w || !w->length || !stamp) return FAILURE;
+
+    *stamp = w->candidates[w->front].stamp;
+
+    return SUCCESS;
+}
+
+void window_extremum__clear(const WindowExtremum w) {
+    if (!w) return;
+
+    for (size_t i = w->front; i < w->back; i++) {
+        drop(w, w->candidates[i].elem);
+    }
+
+    w->front = 0;
+    w->back = 0;
+    w->length = 0;
+    w->last_stamp = 0;
+    w->started = false;
+    WINDOW_RESIZE(w, DEFAULT_WINDOW_CAPACITY);
+}
+
+void window_extremum__free(const WindowExtremum w) {
+    if (!w) return;
+
+    for (size_t i = w->front; i < w->back; i++) {
+        drop(w, w->candidates[i].elem);
+    }
+
+    free(w->candidates);
+    free(w);
+}
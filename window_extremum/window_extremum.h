@@ -0,0 +1,126 @@
+#ifndef __WINDOW_EXTREMUM_H__
+#define __WINDOW_EXTREMUM_H__
+
+#include <stddef.h>
+
+#include "../common/defs.h"
+
+
+/**
+ * Implementation of a sliding window extremum, based on a monotonic deque
+ *
+ * Notes :
+ * 1) The window keeps the minimum of its elements according to the compare function, a window keeping
+ * the maximum is obtained with a reversed compare function.
+ *
+ * 2) Every element is pushed with a stamp, an index or a time, stamps must be non-decreasing. The window
+ * holds the elements whose stamp is in (last stamp - width, last stamp], older ones expire automatically.
+ * A width of 0 disables the automatic expiry, elements are then expired with 'window_extremum__expire'.
+ *
+ * 3) Only the candidates to the extremum are stored: an element is dropped as soon as a newer element
+ * compares less or equal to it, since it can never be the extremum again. Each element is therefore
+ * stored and dropped once, pushing costs O(1) amortized whatever the width.
+ *
+ * 4) Dropped and expired elements are deleted with the delete operator, if any. The window never copies its elements.
+ */
+typedef struct WindowExtremumSt * WindowExtremum;
+
+
+/**
+ * @brief create an empty window
+ * @note complexity: O(1)
+ * @param width width of the window in stamps, 0 to disable the automatic expiry
+ * @param cmp the compare function, receives pointers to elements as with qsort
+ * @param delete_op the delete operator, NULL if the window does not own its elements
+ * @return a pointer to the window on success, NULL on failure
+ */
+WindowExtremum window_extremum__empty(const uint64_t width, const compare_func_t cmp, const delete_operator_t delete_op);
+
+
+/**
+ * @brief checks if the window is empty
+ * @note complexity: O(1)
+ * @param w the window
+ * @return 1 if the window is empty, 0 if not, -1 on failure
+ */
+char window_extremum__is_empty(const WindowExtremum w);
+
+
+/**
+ * @brief number of candidates to the extremum stored in the window
+ * @note complexity: O(1)
+ * @param w the window
+ * @return the number of candidates on success, SIZE_MAX on failure
+ */
+size_t window_extremum__length(const WindowExtremum w);
+
+
+/**
+ * @brief pushes an element with the stamp following the last one
+ * @note complexity: O(1) amortized
+ * @param w the window
+ * @param element the element
+ * @return 0 on success, -1 on failure
+ */
+char window_extremum__push(const WindowExtremum w, const elem_t element);
+
+
+/**
+ * @brief pushes an element with the given stamp, the elements leaving the window expire
+ * @note complexity: O(1) amortized
+ * @param w the window
+ * @param element the element
+ * @param stamp the stamp of the element, not less than the last stamp
+ * @return 0 on success, -1 on failure
+ */
+char window_extremum__push_at(const WindowExtremum w, const elem_t element, const uint64_t stamp);
+
+
+/**
+ * @brief expires the elements whose stamp is less than the given one
+ * @note complexity: O(1) amortized
+ * @param w the window
+ * @param stamp the stamp of the oldest element to keep
+ * @return 0 on success, -1 on failure
+ */
+char window_extremum__expire(const WindowExtremum w, const uint64_t stamp);
+
+
+/**
+ * @brief retrieve the extremum of the window without removing it
+ * @details the element itself is given, not a copy
+ * @note complexity: O(1)
+ * @param w the window
+ * @param extremum pointer to storage variable
+ * @return 0 on success, -1 on failure
+ */
+char window_extremum__peek(const WindowExtremum w, elem_t *extremum);
+
+
+/**
+ * @brief retrieve the stamp of the extremum of the window
+ * @note complexity: O(1)
+ * @param w the window
+ * @param stamp pointer to storage variable
+ * @return 0 on success, -1 on failure
+ */
+char window_extremum__peek_stamp(const WindowExtremum w, uint64_t *stamp);
+
+
+/**
+ * @brief removes all elements of the window, the stamps restart from 0
+ * @note complexity: O(n)
+ * @param w the window
+ */
+void window_extremum__clear(const WindowExtremum w);
+
+
+/**
+ * @brief frees all allocated memory used by the window and deletes its elements
+ * @note complexity: O(n)
+ * @param w the window
+ */
+void window_extremum__free(const WindowExtremum w);
+
+
+#endif